@@ -0,0 +1,425 @@
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+#include <SFUI.hpp>
+
+using namespace sf;
+
+namespace
+{
+    struct Result
+    {
+        std::string     Name;
+        unsigned int    Widgets;
+        unsigned int    Runs;
+        float           Total;
+        float           Min;
+    };
+
+    std::vector<Result> results;
+
+    void    AddResult(const std::string& name, unsigned int widgets, const std::vector<float>& times)
+    {
+        Result result = { name, widgets, static_cast<unsigned int>(times.size()), 0.f, times.front() };
+
+        for (size_t i = 0; i < times.size(); ++i)
+        {
+            result.Total += times[i];
+            if (times[i] < result.Min)
+                result.Min = times[i];
+        }
+        results.push_back(result);
+
+        std::cerr << name << " (" << widgets << " widgets) : " << result.Total * 1000.f / result.Runs << " ms" << std::endl;
+    }
+
+    // Widgets are grouped by 10 : widget i is a child of widget (i - 1) / 10, aligned in one of 9 positions
+    void    BuildTree(std::vector<ui::Widget*>& widgets, unsigned int count)
+    {
+        widgets.reserve(count);
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            ui::Widget* widget = new ui::Widget();
+
+            if (i == 0)
+            {
+                widget->SetSize(800.f, 600.f);
+            }
+            else
+            {
+                ui::Widget* parent = widgets[(i - 1) / 10];
+
+                widget->SetSize(parent->GetWidth() * 0.3f, parent->GetHeight() * 0.3f);
+                widget->SetAlignment(static_cast<ui::Align::Alignment>((i - 1) % 9));
+                parent->Add(widget);
+            }
+            widgets.push_back(widget);
+        }
+    }
+
+    void    DestroyTree(std::vector<ui::Widget*>& widgets)
+    {
+        for (size_t i = widgets.size(); i > 0; --i)
+            delete widgets[i - 1];
+        widgets.clear();
+    }
+
+    void    Run(ui::GuiRenderer& gui, RenderImage* image, unsigned int count, unsigned int events)
+    {
+        const unsigned int runs = std::max(3u, std::min(100u, 100000u / count));
+        std::vector<ui::Widget*> widgets;
+        std::vector<float> construct, destroy, loadStyle, injectEvent, layout, render, softwareRender;
+        ui::SoftwareRenderer software(800, 600);
+        Clock clock;
+
+        for (unsigned int run = 0; run < runs; ++run)
+        {
+            clock.Reset();
+            BuildTree(widgets, count);
+            construct.push_back(clock.GetElapsedTime());
+
+            gui.Add(widgets.front());
+
+            // Each run starts with the same focus, the widget focused by the last run was destroyed
+            gui.SetFocusedWidget(&gui);
+
+            clock.Reset();
+            for (size_t i = 0; i < widgets.size(); ++i)
+                widgets[i]->LoadStyle("Bench");
+            loadStyle.push_back(clock.GetElapsedTime());
+
+            // Mouse moves over a grid covering the view, with a click (press and release) every 10 events
+            Event event;
+
+            clock.Reset();
+            for (unsigned int i = 0; i < events; ++i)
+            {
+                event.Type = Event::MouseMoved;
+                event.MouseMove.X = (i * 37) % 800;
+                event.MouseMove.Y = (i * 53) % 600;
+                gui.InjectEvent(event);
+
+                if (i % 10 == 9)
+                {
+                    event.Type = Event::MouseButtonPressed;
+                    event.MouseButton.Button = Mouse::Left;
+                    event.MouseButton.X = (i * 37) % 800;
+                    event.MouseButton.Y = (i * 53) % 600;
+                    gui.InjectEvent(event);
+
+                    event.Type = Event::MouseButtonReleased;
+                    gui.InjectEvent(event);
+                }
+            }
+            injectEvent.push_back(clock.GetElapsedTime());
+
+            // Resizing each widget realigns its children, from the root to the leaves
+            clock.Reset();
+            for (size_t i = 0; i < widgets.size(); ++i)
+                widgets[i]->SetSize(widgets[i]->GetSize());
+            layout.push_back(clock.GetElapsedTime());
+
+            if (image)
+            {
+                clock.Reset();
+                image->Clear();
+                gui.Display();
+                image->Display();
+                render.push_back(clock.GetElapsedTime());
+            }
+
+            clock.Reset();
+            software.Clear();
+            software.Render(gui);
+            softwareRender.push_back(clock.GetElapsedTime());
+
+            gui.Remove(widgets.front());
+
+            clock.Reset();
+            DestroyTree(widgets);
+            destroy.push_back(clock.GetElapsedTime());
+        }
+
+        AddResult("construct", count, construct);
+        AddResult("loadStyle", count, loadStyle);
+        AddResult("injectEvent", count, injectEvent);
+        AddResult("layout", count, layout);
+        if (image)
+            AddResult("render", count, render);
+        AddResult("softwareRender", count, softwareRender);
+        AddResult("destroy", count, destroy);
+    }
+
+    void    WriteJson(std::ostream& stream, unsigned int events, bool rendered)
+    {
+        stream << "{\n  \"events\": " << events << ",\n  \"render\": " << (rendered ? "true" : "false")
+               << ",\n  \"kernels\": \"" << ui::Raster::GetKernelName() << "\",\n  \"results\": [";
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& result = results[i];
+
+            stream << (i ? ",\n" : "\n")
+                   << "    { \"name\": \"" << result.Name << "\", \"widgets\": " << result.Widgets
+                   << ", \"runs\": " << result.Runs
+                   << ", \"meanMs\": " << result.Total * 1000.f / result.Runs
+                   << ", \"minMs\": " << result.Min * 1000.f
+                   << ", \"nsPerWidget\": " << result.Total * 1e9f / result.Runs / result.Widgets << " }";
+        }
+        stream << "\n  ]\n}\n";
+    }
+
+    // Replay scene : a movable window with a text input and a slider, above a tree of 1000 widgets
+    struct Scene
+    {
+        Scene()
+            :   Window(L"Bench"),
+                Input(L""),
+                Slider(ui::Slider::HORIZONTAL)
+        {}
+
+        ui::Window                  Window;
+        ui::TextInput               Input;
+        ui::Slider                  Slider;
+        std::vector<ui::Widget*>    Background;
+    };
+
+    void    BuildScene(ui::GuiRenderer& gui, Scene& scene)
+    {
+        BuildTree(scene.Background, 1000);
+        gui.Add(scene.Background.front());
+
+        scene.Window.SetPosition(100.f, 100.f);
+        scene.Window.SetSize(300.f, 200.f);
+
+        scene.Input.SetPosition(20.f, 60.f);
+        scene.Input.SetSize(200.f, 24.f);
+        scene.Window.Add(&scene.Input);
+
+        scene.Slider.SetPosition(20.f, 120.f);
+        scene.Slider.SetSize(200.f, 16.f);
+        scene.Window.Add(&scene.Slider);
+
+        gui.Add(&scene.Window);
+    }
+
+    void    Inject(ui::GuiRenderer& gui, ui::EventRecorder& recorder, RenderImage* image, const Event& event, unsigned int& count)
+    {
+        gui.InjectEvent(event);
+
+        // A frame every 4 events
+        if (++count % 4 == 0)
+        {
+            if (image)
+                gui.Display();
+            else
+                recorder.RecordFrame();
+        }
+    }
+
+    void    InjectMouse(ui::GuiRenderer& gui, ui::EventRecorder& recorder, RenderImage* image, Event::EventType type, int x, int y, unsigned int& count)
+    {
+        Event event;
+
+        event.Type = type;
+        if (type == Event::MouseMoved)
+        {
+            event.MouseMove.X = x;
+            event.MouseMove.Y = y;
+        }
+        else
+        {
+            event.MouseButton.Button = Mouse::Left;
+            event.MouseButton.X = x;
+            event.MouseButton.Y = y;
+        }
+        Inject(gui, recorder, image, event, count);
+    }
+
+    // Scripted session : window drag, typing burst and slider scrubbing
+    unsigned int    GenerateSession(ui::GuiRenderer& gui, Scene& scene, ui::EventRecorder& recorder, RenderImage* image)
+    {
+        unsigned int count = 0;
+        Vector2f pos = scene.Window.GetAbsolutePosition();
+
+        InjectMouse(gui, recorder, image, Event::MouseMoved, pos.x + 10, pos.y + 5, count);
+        InjectMouse(gui, recorder, image, Event::MouseButtonPressed, pos.x + 10, pos.y + 5, count);
+        for (int i = 1; i <= 200; ++i)
+            InjectMouse(gui, recorder, image, Event::MouseMoved, pos.x + 10 + i, pos.y + 5 + i / 2, count);
+        InjectMouse(gui, recorder, image, Event::MouseButtonReleased, pos.x + 210, pos.y + 105, count);
+
+        pos = scene.Input.GetAbsolutePosition();
+
+        InjectMouse(gui, recorder, image, Event::MouseMoved, pos.x + 10, pos.y + 10, count);
+        InjectMouse(gui, recorder, image, Event::MouseButtonPressed, pos.x + 10, pos.y + 10, count);
+        InjectMouse(gui, recorder, image, Event::MouseButtonReleased, pos.x + 10, pos.y + 10, count);
+
+        const char text[] = "The quick brown fox jumps over the lazy dog. ";
+        Event event;
+
+        for (unsigned int i = 0; i < 400; ++i)
+        {
+            if (i % 20 == 19)
+            {
+                event.Type = Event::KeyPressed;
+                event.Key.Code = Key::Back;
+                event.Key.Alt = event.Key.Control = event.Key.Shift = false;
+            }
+            else
+            {
+                event.Type = Event::TextEntered;
+                event.Text.Unicode = text[i % (sizeof(text) - 1)];
+            }
+            Inject(gui, recorder, image, event, count);
+        }
+
+        pos = scene.Slider.GetAbsolutePosition();
+
+        InjectMouse(gui, recorder, image, Event::MouseMoved, pos.x + 5, pos.y + 5, count);
+        InjectMouse(gui, recorder, image, Event::MouseButtonPressed, pos.x + 5, pos.y + 5, count);
+        for (int i = 0; i < 400; ++i)
+            InjectMouse(gui, recorder, image, Event::MouseMoved, pos.x + 5 + ((i < 200) ? i : 400 - i), pos.y + 5, count);
+        InjectMouse(gui, recorder, image, Event::MouseButtonReleased, pos.x + 5, pos.y + 5, count);
+
+        return count;
+    }
+
+    bool    WriteOutput(const std::string& output, const std::string& json)
+    {
+        if (output.empty())
+        {
+            std::cout << json;
+            return true;
+        }
+
+        std::ofstream file(output.c_str());
+
+        if (!file)
+        {
+            std::cerr << "Could not write \"" << output << "\" results file" << std::endl;
+            return false;
+        }
+        file << json;
+        return true;
+    }
+}
+
+int main(int ac, char **av)
+{
+    std::string output, replay, generate;
+    unsigned int events = 1000;
+    bool headless = false;
+
+    for (int i = 1; i < ac; ++i)
+    {
+        if (!std::strcmp(av[i], "--output") && i + 1 < ac)
+            output = av[++i];
+        else if (!std::strcmp(av[i], "--events") && i + 1 < ac)
+            events = std::atoi(av[++i]);
+        else if (!std::strcmp(av[i], "--no-render"))
+            headless = true;
+        else if (!std::strcmp(av[i], "--replay") && i + 1 < ac)
+            replay = av[++i];
+        else if (!std::strcmp(av[i], "--generate") && i + 1 < ac)
+            generate = av[++i];
+        else if (!std::strcmp(av[i], "--kernels") && i + 1 < ac)
+        {
+            // Software rendering kernels to compare, the best supported ones by default
+            const std::string name = av[++i];
+            const ui::Raster::Kernels kernels = (name == "avx2") ? ui::Raster::AVX2 : (name == "sse2") ? ui::Raster::SSE2 : ui::Raster::SCALAR;
+
+            if (!ui::Raster::SetKernels(kernels))
+                std::cerr << "\"" << name << "\" kernels are not supported, using " << ui::Raster::GetKernelName() << std::endl;
+        }
+        else
+        {
+            std::cerr << "Usage : " << av[0] << " [--output results.json] [--events count] [--no-render] [--kernels scalar|sse2|avx2]" << std::endl;
+            std::cerr << "        " << av[0] << " --generate session.sfev [--no-render]" << std::endl;
+            std::cerr << "        " << av[0] << " --replay session.sfev [--output results.json] [--no-render]" << std::endl;
+            return (EXIT_FAILURE);
+        }
+    }
+
+    // Rendering is done offscreen, it is skipped when render images are not supported
+    RenderImage image;
+    bool rendered = !headless && RenderImage::IsAvailable() && image.Create(800, 600);
+
+    if (!headless && !rendered)
+        std::cerr << "Render images are not available, render traversal is not measured" << std::endl;
+
+    ui::GuiRenderer gui(image);
+
+    gui.SetSize(800.f, 600.f);
+
+    // Styles are filled in memory, no style file is needed
+    ui::ResourceManager* rm = ui::ResourceManager::Get();
+
+    rm->GetStyle("BenchBase")["color"] = "rgba:64,64,64,128";
+    rm->GetStyle("BenchBase")["borderColor"] = "#FFFFFF";
+    rm->GetStyle("Bench")["from"] = "BenchBase";
+    rm->GetStyle("Bench")["enabled"] = "1";
+
+    std::ostringstream json;
+
+    if (!generate.empty())
+    {
+        Scene scene;
+        ui::EventRecorder recorder;
+
+        BuildScene(gui, scene);
+
+        if (!recorder.Open(generate))
+            return (EXIT_FAILURE);
+
+        gui.SetEventRecorder(&recorder);
+        GenerateSession(gui, scene, recorder, rendered ? &image : 0);
+        gui.SetEventRecorder(0);
+
+        std::cerr << recorder.GetEventCount() << " events written to " << generate << std::endl;
+        DestroyTree(scene.Background);
+        return (EXIT_SUCCESS);
+    }
+    else if (!replay.empty())
+    {
+        Scene scene;
+        ui::EventPlayer player;
+
+        if (!player.LoadFromFile(replay))
+            return (EXIT_FAILURE);
+
+        BuildScene(gui, scene);
+
+        const ui::ReplayStats stats = player.Play(gui, rendered);
+
+        json << "{\n  \"replay\": \"" << replay << "\",\n  \"events\": " << stats.EventCount
+             << ",\n  \"frames\": " << stats.FrameCount
+             << ",\n  \"totalMs\": " << stats.TotalTime * 1000.f
+             << ",\n  \"meanUs\": " << stats.Mean * 1e6f
+             << ",\n  \"p50Us\": " << stats.P50 * 1e6f
+             << ",\n  \"p90Us\": " << stats.P90 * 1e6f
+             << ",\n  \"p99Us\": " << stats.P99 * 1e6f
+             << ",\n  \"maxUs\": " << stats.Max * 1e6f << "\n}\n";
+
+        DestroyTree(scene.Background);
+    }
+    else
+    {
+        const unsigned int sizes[] = { 10, 100, 1000, 10000 };
+
+        for (unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+            Run(gui, rendered ? &image : 0, sizes[i], events);
+
+        WriteJson(json, events, rendered);
+    }
+
+    return WriteOutput(output, json.str()) ? (EXIT_SUCCESS) : (EXIT_FAILURE);
+}
@@ -42,6 +42,22 @@
 #include <SFUI/Window.hpp>
 #include <SFUI/Slider.hpp>
 
+#include <SFUI/Animator.hpp>
+#include <SFUI/DistanceFieldFont.hpp>
+#include <SFUI/DistanceFieldText.hpp>
+#include <SFUI/DockSpace.hpp>
+#include <SFUI/EventRecorder.hpp>
+#include <SFUI/GlyphAtlas.hpp>
+#include <SFUI/Layout.hpp>
+#include <SFUI/LayoutFile.hpp>
+#include <SFUI/Profiler.hpp>
+#include <SFUI/ProfilerOverlay.hpp>
+#include <SFUI/RasterKernels.hpp>
+#include <SFUI/RenderCommandList.hpp>
+#include <SFUI/Semaphore.hpp>
+#include <SFUI/SoftwareRenderer.hpp>
+#include <SFUI/TaskPool.hpp>
+
 /** \mainpage SFUI Documentation
  *
  * \section intro_sec Introduction
@@ -0,0 +1,227 @@
+#ifndef ANIMATOR_HPP_INCLUDED
+#define ANIMATOR_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file Animator.hpp
+ * \brief Tween widget properties over time.
+ * \author Robin Ruaux
+ */
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        class Widget;
+
+        /** \class Animator
+         *
+         * \brief Tween widget properties over time.
+         *
+         * Animations are stored as parallel arrays and updated together, once per frame, by
+         * GuiRenderer::Display() before the widgets are drawn : the interpolation of all animations
+         * is a few tight loops, followed by one setter call per animation.
+         *
+         * A new animation of a widget property replaces the running one, starting from the current
+         * value. Animations of deleted widgets are removed. The color and alpha animations of a
+         * widget should not overlap, the last one applied wins.
+         *
+         * Setters called by Update() may start and stop animations, or delete widgets : animations
+         * stopped meanwhile are only marked, and removed once all the values are applied.
+         */
+        class Animator
+        {
+            public :
+
+                /** \enum Easing
+                 *
+                 * \brief Speed curve of an animation.
+                 */
+                enum Easing
+                {
+                    LINEAR,         ///< Constant speed.
+                    EASE_IN,        ///< Starts slowly.
+                    EASE_OUT,       ///< Ends slowly.
+                    EASE_IN_OUT     ///< Starts and ends slowly.
+                };
+
+
+                /** \brief Constructor
+                 *
+                 * Constructor of Animator class.
+                 */
+                Animator();
+
+
+                /** \brief Animate the alpha of a widget color.
+                 *
+                 * \param widget The widget to animate.
+                 * \param alpha The final alpha.
+                 * \param duration The duration, in seconds.
+                 * \param easing The speed curve.
+                 */
+                void                AnimateAlpha(Widget& widget, Uint8 alpha, float duration, Easing easing = EASE_IN_OUT);
+
+
+                /** \brief Animate the color of a widget.
+                 *
+                 * \param widget The widget to animate.
+                 * \param color The final color.
+                 * \param duration The duration, in seconds.
+                 * \param easing The speed curve.
+                 */
+                void                AnimateColor(Widget& widget, const Color& color, float duration, Easing easing = EASE_IN_OUT);
+
+
+                /** \brief Animate the opacity of a widget.
+                 *
+                 * Fading a widget this way fades its children too, without changing their colors.
+                 * \param widget The widget to animate.
+                 * \param opacity The final opacity, from 0 to 1.
+                 * \param duration The duration, in seconds.
+                 * \param easing The speed curve.
+                 */
+                void                AnimateOpacity(Widget& widget, float opacity, float duration, Easing easing = EASE_IN_OUT);
+
+
+                /** \brief Animate the position of a widget.
+                 *
+                 * \param widget The widget to animate.
+                 * \param position The final position, relative to the parent.
+                 * \param duration The duration, in seconds.
+                 * \param easing The speed curve.
+                 */
+                void                AnimatePosition(Widget& widget, const Vector2f& position, float duration, Easing easing = EASE_IN_OUT);
+
+
+                /** \brief Animate the size of a widget.
+                 *
+                 * \param widget The widget to animate.
+                 * \param size The final size.
+                 * \param duration The duration, in seconds.
+                 * \param easing The speed curve.
+                 */
+                void                AnimateSize(Widget& widget, const Vector2f& size, float duration, Easing easing = EASE_IN_OUT);
+
+
+                /** \brief Get the number of running animations.
+                 *
+                 * \return The number of animations.
+                 */
+                unsigned int        GetCount() const;
+
+
+                /** \brief Tell if a widget is animated.
+                 *
+                 * \param widget The widget.
+                 * \return True if one of the widget properties is animated.
+                 */
+                bool                IsAnimated(const Widget& widget) const;
+
+
+                /** \brief Stop the animations of a widget.
+                 *
+                 * The animated properties keep their current values.
+                 * \param widget The widget.
+                 */
+                void                Stop(const Widget& widget);
+
+
+                /** \brief Advance the animations and apply their values.
+                 *
+                 * Finished animations are applied a last time with their final values, then removed.
+                 * \param elapsed The time elapsed since the last update, in seconds.
+                 */
+                void                Update(float elapsed);
+
+
+            private :
+
+                enum Property
+                {
+                    ALPHA,
+                    COLOR,
+                    OPACITY,
+                    POSITION,
+                    SIZE
+                };
+
+                /** \brief Add an animation, or restart the running one of the same property. */
+                void                Add(Widget& widget, Property property, const float* from, const float* to, float duration, Easing easing);
+
+                /** \brief Stop an animation : removed at once, or marked during an update. */
+                void                Kill(unsigned int index);
+
+                /** \brief Remove an animation, the last one takes its place. */
+                void                Remove(unsigned int index);
+
+                typedef std::pair<const Widget*, Uint8>         Key;
+
+                typedef std::map<Key, unsigned int>             Indices;
+
+                std::vector<float>          mCubic;
+
+                std::vector<float>          mDurations;
+
+                std::vector<float>          mElapsed;
+
+                std::vector<float>          mFrom[4];
+
+                Indices                     mIndices;
+
+                std::vector<float>          mLinear;
+
+                std::vector<float>          mProgress;
+
+                std::vector<Uint8>          mProperties;
+
+                std::vector<float>          mQuadratic;
+
+                std::vector<float>          mTo[4];
+
+                bool                        mUpdating;
+
+                std::vector<float>          mValues[4];
+
+                std::vector<Widget*>        mWidgets;
+
+        };
+
+    }
+
+}
+
+#endif // ANIMATOR_HPP_INCLUDED
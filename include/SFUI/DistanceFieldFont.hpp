@@ -0,0 +1,167 @@
+#ifndef DISTANCEFIELDFONT_HPP_INCLUDED
+#define DISTANCEFIELDFONT_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file DistanceFieldFont.hpp
+ * \brief Signed distance field glyph atlas, to draw text crisply at any size.
+ * \author Robin Ruaux
+ */
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+namespace sf
+{
+    class Font;
+    class RenderTarget;
+
+    namespace ui
+    {
+        class GlyphAtlas;
+
+        /** \class DistanceFieldFont
+         *
+         * \brief Signed distance field glyph atlas, to draw text crisply at any size.
+         *
+         * A sf::Font is a bitmap atlas for one character size : other sizes are obtained by scaling
+         * the glyph bitmaps, which blurs or pixelates them. A distance field stores, for each texel,
+         * the distance to the nearest glyph edge : thresholding the interpolated distance gives sharp
+         * glyph edges at any scale.
+         *
+         * The distance field is generated once from the font file rendered at GetBaseSize(). A glyph
+         * image is rasterized from it the first time the glyph is requested at a character size, into
+         * a GlyphAtlas which may be shared with other fonts. All sizes share the single font load and
+         * distance field, instead of one sf::Font per size.
+         *
+         * Fonts are usually obtained with ResourceManager::GetDistanceField() and drawn with a DistanceFieldText.
+         */
+        class DistanceFieldFont
+        {
+            public :
+
+                /** \struct Glyph
+                 *
+                 * \brief A glyph of a character size.
+                 */
+                struct Glyph
+                {
+                    Glyph() : Advance(0) {}
+
+                    int         Advance;    ///< Horizontal offset to the next character.
+                    IntRect     Rectangle;  ///< Glyph box, relative to the pen position on the baseline.
+                    IntRect     Source;     ///< Glyph box in the atlas image, in pixels.
+                };
+
+
+                /** \brief Constructor
+                 *
+                 * Constructor of DistanceFieldFont class.
+                 * \param atlas The atlas the glyphs are rasterized into.
+                 */
+                explicit DistanceFieldFont(GlyphAtlas& atlas);
+
+
+                /** \brief Generate the distance field from a font file.
+                 *
+                 * \param filename The font file.
+                 * \return True if the distance field has been generated.
+                 */
+                bool                LoadFromFile(const std::string& filename);
+
+
+                /** \brief Get the size the distance field is generated at.
+                 *
+                 * \return The base size, in pixels.
+                 */
+                unsigned int        GetBaseSize() const;
+
+
+                /** \brief Get a glyph, rasterizing it if needed.
+                 *
+                 * \param codePoint The unicode character.
+                 * \param characterSize The character size, in pixels.
+                 * \return The glyph, an empty glyph if the character is not in the font.
+                 */
+                const Glyph&        GetGlyph(Uint32 codePoint, unsigned int characterSize) const;
+
+
+                /** \brief Get the atlas image.
+                 *
+                 * The image is white, its alpha channel is the glyph coverage. It should be requested after
+                 * the glyphs, so that it contains them (see GlyphAtlas::GetImage()).
+                 * \param target The target to flush before the image grows (NULL for none).
+                 * \return The atlas image.
+                 */
+                const Image&        GetImage(RenderTarget* target = 0) const;
+
+
+                /** \brief Sample the distance field with a bilinear filter.
+                 *
+                 * \param x The horizontal position in the distance field, in pixels.
+                 * \param y The vertical position in the distance field, in pixels.
+                 * \return The signed distance to the nearest edge, positive inside the glyph, in pixels of the base size.
+                 */
+                float               Sample(float x, float y) const;
+
+
+            private :
+
+                typedef std::map<Uint32, Glyph>                             Glyphs;
+
+                typedef std::map<std::pair<unsigned int, Uint32>, Glyph>    SizedGlyphs;
+
+                DistanceFieldFont(const DistanceFieldFont&);
+
+                DistanceFieldFont&  operator=(const DistanceFieldFont&);
+
+                GlyphAtlas&         mAtlas;
+
+                std::vector<Uint8>  mDistances;
+
+                Glyphs              mGlyphs;
+
+                unsigned int        mHeight;
+
+                mutable SizedGlyphs mSizedGlyphs;
+
+                unsigned int        mWidth;
+
+        };
+
+    }
+
+}
+
+#endif // DISTANCEFIELDFONT_HPP_INCLUDED
@@ -0,0 +1,122 @@
+#ifndef DISTANCEFIELDTEXT_HPP_INCLUDED
+#define DISTANCEFIELDTEXT_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file DistanceFieldText.hpp
+ * \brief A string drawn with a distance field font.
+ * \author Robin Ruaux
+ */
+
+#include <vector>
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+namespace sf
+{
+    class Image;
+    class String;
+
+    namespace ui
+    {
+        class DistanceFieldFont;
+
+        /** \class DistanceFieldText
+         *
+         * \brief A string drawn with a distance field font.
+         *
+         * The text takes the text, size, position and color of a sf::String, and lays it out like
+         * sf::String does, with the glyphs of the distance field font at the string size.
+         * The glyph quads are kept, so that the same object can be reused for many strings
+         * without memory allocation.
+         */
+        class DistanceFieldText : public Drawable
+        {
+            public :
+
+                /** \struct Quad
+                 *
+                 * \brief A glyph quad.
+                 */
+                struct Quad
+                {
+                    FloatRect   Dest;   ///< Glyph rectangle, relative to the text position.
+                    IntRect     Source; ///< Glyph rectangle in the image, in pixels.
+                };
+
+
+                /** \brief Constructor
+                 *
+                 * Constructor of DistanceFieldText class.
+                 */
+                DistanceFieldText();
+
+
+                /** \brief Get the glyph image.
+                 *
+                 * The glyphs added to the atlas are uploaded first : it must be called by the thread which draws.
+                 * \return The glyph atlas image of the font, NULL if no string is set.
+                 */
+                const Image*                GetImage() const;
+
+
+                /** \brief Get the glyph quads.
+                 *
+                 * \return The quads of the visible glyphs.
+                 */
+                const std::vector<Quad>&    GetQuads() const;
+
+
+                /** \brief Lay out a string.
+                 *
+                 * \param font The distance field font of the string font.
+                 * \param string The string to lay out.
+                 */
+                void                        SetString(const DistanceFieldFont& font, const String& string);
+
+
+            protected :
+
+                virtual void                Render(RenderTarget& target, RenderQueue& queue) const;
+
+
+            private :
+
+                const DistanceFieldFont*    mFont;
+
+                std::vector<Quad>           mQuads;
+
+        };
+
+    }
+
+}
+
+#endif // DISTANCEFIELDTEXT_HPP_INCLUDED
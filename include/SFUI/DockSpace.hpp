@@ -0,0 +1,191 @@
+#ifndef DOCKSPACE_HPP_INCLUDED
+#define DOCKSPACE_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file DockSpace.hpp
+ * \brief A container tiling windows in a split tree.
+ * \author Robin Ruaux
+ */
+
+#include <map>
+
+#include <SFUI/Window.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** \class DockSpace
+         *
+         * \brief A container tiling its windows in a tree of splits.
+         *
+         * Each leaf of the tree holds one or more windows as tabs, only the active tab is shown : the other ones
+         * are hidden, so they are neither drawn nor hit-tested. Docked windows can't be moved by the mouse and
+         * are placed by the dock space, changing a split only places the windows under it.
+         *
+         * Windows deleted or removed from the dock space are undocked, their area is merged with its neighbour
+         * when it has no other tab.
+         */
+        class DockSpace : public Widget
+        {
+            public :
+
+                typedef enum
+                {
+                    TAB,
+                    LEFT,
+                    RIGHT,
+                    TOP,
+                    BOTTOM
+                }   DockSide;
+
+
+                /** \brief Constructor
+                 *
+                 * Constructor of DockSpace class.
+                 */
+                DockSpace();
+
+
+                /** \brief Destructor
+                 *
+                 * Destructor of DockSpace class.
+                 */
+                ~DockSpace();
+
+
+                /** \brief Dock a window.
+                 *
+                 * The window becomes a child of the dock space. Docked beside a target, the target area is split in two,
+                 * docked as a tab, the window shares the target area and becomes its active tab.
+                 * With no target, the window is docked along a side of the whole space (as a tab when the space is empty).
+                 * \param window The window to dock.
+                 * \param target A docked window, or 0 for the whole space.
+                 * \param side Where to dock the window, relative to the target.
+                 * \param ratio The share of the split area given to the window.
+                 * \return True if the window has been docked.
+                 */
+                bool                    Dock(Window* window, Window* target = 0, DockSide side = TAB, float ratio = 0.5f);
+
+
+                /** \brief Get the tab shown in the area of a window.
+                 *
+                 * \param window A docked window.
+                 * \return The active tab of the window area (0 if the window isn't docked).
+                 */
+                Window*                 GetActiveTab(const Window* window) const;
+
+
+                /** \brief Get the space between two split areas.
+                 *
+                 * \return The spacing.
+                 */
+                float                   GetSpacing() const;
+
+
+                /** \brief Check if a window is docked in the dock space.
+                 *
+                 * \param window The window.
+                 * \return True if the window is docked.
+                 */
+                bool                    IsDocked(const Window* window) const;
+
+
+                virtual void            LoadStyle(const std::string& nameStyle);
+
+
+                /** \brief Show a tab, and hide the other tabs of its area.
+                 *
+                 * \param window A docked window.
+                 */
+                void                    SetActiveTab(Window* window);
+
+
+                /** \brief Set the space between two split areas.
+                 *
+                 * \param spacing The new spacing.
+                 */
+                void                    SetSpacing(float spacing);
+
+
+                /** \brief Resize the split holding a window area.
+                 *
+                 * Only the windows of that split are placed again.
+                 * \param window A docked window.
+                 * \param ratio The share of the split given to the window area, from 0 to 1.
+                 */
+                void                    SetSplitRatio(const Window* window, float ratio);
+
+
+                /** \brief Undock a window.
+                 *
+                 * The window is removed from the dock space, shown and movable again. The area of the
+                 * window is merged with its neighbour when it has no other tab.
+                 * \param window The window to undock.
+                 */
+                void                    Undock(Window* window);
+
+            protected :
+
+                virtual void            OnChange(Widget::Property property);
+
+                virtual void            OnChildRemoved(const Widget* child);
+
+            private :
+
+                struct Node;
+
+                typedef std::map<const Widget*, Node*>  Leaves;
+
+                /** \brief Place the windows of a node in its area. */
+                void                    Arrange(Node* node, const FloatRect& rect);
+
+                /** \brief Delete a node and its children. */
+                void                    DeleteNode(Node* node);
+
+                /** \brief Move the content of a node into another one. */
+                void                    MoveNode(Node* from, Node* to);
+
+                /** \brief Forget a docked window, merge its area with its neighbour when it has no other tab. */
+                void                    RemoveTab(const Widget* window);
+
+                Leaves                  mLeaves;
+
+                Node*                   mRoot;
+
+                float                   mSpacing;
+
+        };
+
+    }
+
+}
+
+#endif // DOCKSPACE_HPP_INCLUDED
@@ -0,0 +1,228 @@
+#ifndef EVENTRECORDER_HPP_INCLUDED
+#define EVENTRECORDER_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file EventRecorder.hpp
+ * \brief Record and replay the events injected to the gui.
+ * \author Robin Ruaux
+ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/Window/Event.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        class GuiRenderer;
+
+        /** \class EventRecorder
+         *
+         * \brief Record the events injected to the gui in a compact file.
+         *
+         * Once given to GuiRenderer::SetEventRecorder(), the recorder stores each injected event and
+         * each displayed frame. Records are variable length : the time since the previous record and
+         * the mouse position since the previous mouse event are stored as deltas.
+         */
+        class EventRecorder
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of EventRecorder class.
+                 */
+                EventRecorder();
+
+
+                /** \brief Destructor
+                 *
+                 * The record file is closed.
+                 */
+                ~EventRecorder();
+
+
+                /** \brief Close the record file.
+                 *
+                 */
+                void                Close();
+
+
+                /** \brief Get the number of recorded events.
+                 *
+                 * \return The number of events.
+                 */
+                unsigned int        GetEventCount() const;
+
+
+                /** \brief Check if a record file is open.
+                 *
+                 * \return True if events are recorded.
+                 */
+                bool                IsOpen() const;
+
+
+                /** \brief Open a record file.
+                 *
+                 * \param filename The name of the file to write.
+                 * \return True if the file could be opened.
+                 */
+                bool                Open(const std::string& filename);
+
+
+                /** \brief Record an event.
+                 *
+                 * \param event The event injected to the gui.
+                 */
+                void                Record(const Event& event);
+
+
+                /** \brief Record the end of a frame.
+                 *
+                 */
+                void                RecordFrame();
+
+
+            private :
+
+                EventRecorder(const EventRecorder&);
+
+                EventRecorder&      operator=(const EventRecorder&);
+
+                void                WriteHeader(Uint8 type);
+
+                void                WriteSigned(Int32 value);
+
+                void                WriteUnsigned(Uint32 value);
+
+                std::vector<Uint8>  mBuffer;
+
+                Clock               mClock;
+
+                unsigned int        mEventCount;
+
+                std::ofstream       mFile;
+
+                int                 mMouseX;
+
+                int                 mMouseY;
+
+        };
+
+
+        /** \struct ReplayStats
+         *
+         * \brief Latencies measured by EventPlayer::Play().
+         */
+        struct ReplayStats
+        {
+            unsigned int    EventCount;     ///< Number of injected events
+            unsigned int    FrameCount;     ///< Number of displayed frames
+            float           TotalTime;      ///< Time spent in GuiRenderer::InjectEvent(), in seconds
+            float           Mean;           ///< Mean latency, in seconds
+            float           P50;            ///< Median latency, in seconds
+            float           P90;            ///< 90th percentile latency, in seconds
+            float           P99;            ///< 99th percentile latency, in seconds
+            float           Max;            ///< Maximum latency, in seconds
+        };
+
+
+        /** \class EventPlayer
+         *
+         * \brief Replay events recorded by an EventRecorder.
+         *
+         * Events are injected as fast as possible, the time of each GuiRenderer::InjectEvent() call is measured.
+         */
+        class EventPlayer
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of EventPlayer class.
+                 */
+                EventPlayer();
+
+
+                /** \brief Get the number of loaded events.
+                 *
+                 * \return The number of events.
+                 */
+                unsigned int        GetEventCount() const;
+
+
+                /** \brief Get the number of loaded frames.
+                 *
+                 * \return The number of frames.
+                 */
+                unsigned int        GetFrameCount() const;
+
+
+                /** \brief Load a record file.
+                 *
+                 * \param filename The name of the file to read.
+                 * \return True if the file has been loaded.
+                 */
+                bool                LoadFromFile(const std::string& filename);
+
+
+                /** \brief Inject the loaded events to a gui.
+                 *
+                 * \param gui The gui to inject events to.
+                 * \param display Call GuiRenderer::Display() at the end of each recorded frame.
+                 * \return The measured latencies.
+                 */
+                ReplayStats         Play(GuiRenderer& gui, bool display = false) const;
+
+
+            private :
+
+                /** Loaded event (or frame end) */
+                struct Entry
+                {
+                    Event           Evt;
+                    bool            Frame;
+                };
+
+                std::vector<Entry>  mEntries;
+
+                unsigned int        mEventCount;
+
+        };
+
+    }
+
+}
+
+#endif // EVENTRECORDER_HPP_INCLUDED
@@ -0,0 +1,132 @@
+#ifndef GLYPHATLAS_HPP_INCLUDED
+#define GLYPHATLAS_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file GlyphAtlas.hpp
+ * \brief A growable image shared by the glyphs of several fonts.
+ * \author Robin Ruaux
+ */
+
+#include <vector>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Mutex.hpp>
+
+namespace sf
+{
+    class RenderTarget;
+
+    namespace ui
+    {
+        /** \class GlyphAtlas
+         *
+         * \brief A growable image shared by the glyphs of several fonts.
+         *
+         * Glyphs are added when they are first drawn, whatever their font and size, so that all the
+         * text shares one texture and can be batched. The image is white, its alpha channel is the glyph
+         * coverage. It starts small and doubles its height when it is full, up to 4096 pixels.
+         *
+         * Added glyphs are uploaded to the image the next time it is requested, only the changed rows
+         * unless the image grew. With the render thread,
+         * glyphs are added by the GUI thread while the render thread draws : the pixels are guarded by a
+         * mutex, and only the thread which draws requests the image (see DistanceFieldText::GetImage()).
+         */
+        class GlyphAtlas
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of GlyphAtlas class.
+                 */
+                GlyphAtlas();
+
+
+                /** \brief Add a glyph.
+                 *
+                 * \param width The glyph width.
+                 * \param height The glyph height.
+                 * \param coverage The glyph coverage, row by row (width x height values).
+                 * \return The glyph rectangle in the image, empty if the atlas is full.
+                 */
+                IntRect             Add(unsigned int width, unsigned int height, const Uint8* coverage);
+
+
+                /** \brief Get the number of glyphs added.
+                 *
+                 * \return The number of glyphs.
+                 */
+                unsigned int        GetGlyphCount() const;
+
+
+                /** \brief Get the atlas image, with all the added glyphs.
+                 *
+                 * The image object stays the same when the atlas grows, only its size changes. The rows of
+                 * the glyphs added since the last call are uploaded, or the whole image when it grew.
+                 * Texture coordinates depend on the image size : vertices queued with the former size are
+                 * drawn before it grows, by flushing the target.
+                 * \param target The target to flush before the image grows (NULL for none).
+                 * \return The atlas image.
+                 */
+                const Image&        GetImage(RenderTarget* target = 0) const;
+
+
+            private :
+
+                mutable Mutex       mAccess;
+
+                mutable IntRect     mDirty;
+
+                unsigned int        mGlyphCount;
+
+                unsigned int        mHeight;
+
+                mutable Image       mImage;
+
+                mutable bool        mModified;
+
+                std::vector<Uint8>  mPixels;
+
+                int                 mRowHeight;
+
+                mutable std::vector<Uint8> mUpload;
+
+                int                 mX;
+
+                int                 mY;
+
+        };
+
+    }
+
+}
+
+#endif // GLYPHATLAS_HPP_INCLUDED
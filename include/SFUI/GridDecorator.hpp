@@ -35,6 +35,7 @@
  */
 
 #include <SFUI/Icon.hpp>
+#include <SFUI/NineSlice.hpp>
 
 namespace sf
 {
@@ -45,7 +46,7 @@ namespace sf
          * \brief A useful decorator for widgets.
          *
          * This widget is relatively particular. It is mostly used by other widget as a decorator.
-         * In fact, its grid is composed by nine Icon widgets, like that :
+         * In fact, its grid is composed by nine image parts, like that :
          * \code
            [ topLeft    ] [ topCenter    ] [ topRight    ]
 
@@ -55,9 +56,11 @@ namespace sf
            \endcode
          *
          * Corners are fixed and all other parts are stretched to the GridDecorator size.
+         * When all parts come from the same image, the grid is drawn in a single batch (see NineSlice).
          *
-         * You can access to each style part :
+         * You can access to each style part, only the image, width and height properties are used :
          * \code <style name="BI_GridDecorator->bottomLeft" image="sub:MyWindow,0,0,13,13" width="14" height="14" /> \endcode
+         * The size of a part defaults to the size of its image.
          */
         class GridDecorator : public Icon
         {
@@ -93,10 +96,22 @@ namespace sf
 
                 virtual void    OnChange(Widget::Property property);
 
-                Icon            mIcons[9];
+                virtual void    OnPaint(Painter& painter) const;
 
             private :
 
+                /** \brief Load the style of a part, inherited styles first. */
+                void            LoadPartStyle(unsigned int part, const std::string& nameStyle);
+
+                /** \brief Place the parts in the decorator area. */
+                void            UpdateParts();
+
+                Sprite          mParts[9];
+
+                Vector2f        mPartSizes[9];
+
+                NineSlice       mSlice;
+
                 bool            mUseGrid;
 
         };
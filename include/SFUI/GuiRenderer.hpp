@@ -34,14 +34,23 @@
  * \author Robin Ruaux
  */
 
+#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/System/Clock.hpp>
 
+#include <SFUI/Animator.hpp>
+#include <SFUI/RenderCommandList.hpp>
+#include <SFUI/Semaphore.hpp>
 #include <SFUI/Widget.hpp>
 
 namespace sf
 {
+    class Thread;
+
     namespace ui
     {
+        class EventRecorder;
+
         typedef     Vector2<unsigned int>   Vector2ui;
 
         /** \class GuiRenderer
@@ -56,9 +65,10 @@ namespace sf
                  *
                  * Constructor of GuiRenderer class.
                  *
-                 * \param renderWindow Needs a reference to the sf::RenderWindow.
+                 * The target is usually a sf::RenderWindow, a sf::RenderImage can be used to render offscreen.
+                 * \param renderTarget Needs a reference to the sf::RenderTarget.
                  */
-                GuiRenderer(RenderWindow& renderWindow);
+                GuiRenderer(RenderTarget& renderTarget);
 
 
                 /** \brief Destructor
@@ -70,10 +80,32 @@ namespace sf
 
                 /** \brief Display the widget hierarchy.
                  *
+                 * Finished background tasks are completed first (see Widget::GetTaskPool()), animations are
+                 * advanced (see Widget::GetAnimator()), then changed style files are re-applied when hot reload
+                 * is enabled (see ResourceManager::EnableHotReload()) and the changed layouts are arranged.
+                 * With the render thread, the hierarchy is recorded and handed to the render thread instead of
+                 * being drawn (see EnableRenderThread()).
+                 * This call closes the current Profiler frame.
                  */
                 virtual void        Display();
 
 
+                /** \brief Draw the frames on a separate thread.
+                 *
+                 * Display() then records the widget hierarchy into a RenderCommandList, which the render thread
+                 * draws while the GUI thread goes on with the events of the next frame. The render thread clears,
+                 * draws and displays the window : the application must not draw to it meanwhile.
+                 *
+                 * Two lists are used in turn, one being recorded while the other one is drawn. Display() only
+                 * waits when the previous frame is not drawn yet.
+                 *
+                 * \param enable True to start the render thread, false to stop it.
+                 * \param clearColor The color the window is cleared with before each frame.
+                 * \return True if the render thread runs (it needs the render target to be a sf::RenderWindow).
+                 */
+                bool                EnableRenderThread(bool enable, const Color& clearColor = Color(0, 0, 0));
+
+
                 /** \brief Get the focused widget.
                  *
                  * \return The focused widget (0 if no one has the focus)
@@ -88,6 +120,13 @@ namespace sf
                 Widget*             GetHoveredWidget() const;
 
 
+                /** \brief Tell if the frames are drawn by a render thread.
+                 *
+                 * \return True if the render thread is enabled.
+                 */
+                bool                IsRenderThreadEnabled() const;
+
+
                 /** \brief Inject a new event to the gui system.
                  *
                  * \param event The event to be injected.
@@ -95,6 +134,13 @@ namespace sf
                 virtual void        InjectEvent(const Event& event);
 
 
+                /** \brief Record the injected events and the displayed frames.
+                 *
+                 * \param recorder The recorder to use (0 to stop recording).
+                 */
+                void                SetEventRecorder(EventRecorder* recorder);
+
+
                 /** \brief Set the widget to be focused.
                  *
                  * \param widget The widget to be focused.
@@ -102,6 +148,16 @@ namespace sf
                 void                SetFocusedWidget(Widget* widget);
 
 
+                /** \brief Switch the GUI to another theme.
+                 *
+                 * The widgets using a changed style are restyled (see ResourceManager::SwitchTheme()).
+                 * \param filename The name of the theme style file.
+                 * \param stats Optional structure filled with the timings.
+                 * \return true if the theme file has been successfuly loaded.
+                 */
+                bool                SwitchTheme(const std::string& filename, PreloadStats* stats = 0);
+
+
             protected :
 
                 void                HandleFocus();
@@ -112,11 +168,37 @@ namespace sf
 
             private :
 
+                static void         RenderFrames(void* userData);
+
                 void                SetHoveredWidget(Widget* widget, const Vector2ui& mouse, Vector2f initialPosition);
 
+                Animator            mAnimations;
+
+                Color               mClearColor;
+
+                Clock               mFrameClock;
+
+                Semaphore           mFrameDrawn;
+
+                RenderCommandList   mFrames[2];
+
+                Semaphore           mFrameSubmitted;
+
+                View                mFrameViews[2];
+
                 bool                mMouseInside;
 
-                RenderWindow&       mRenderWindow;
+                EventRecorder*      mRecorder;
+
+                unsigned int        mRecordedFrame;
+
+                RenderTarget&       mRenderTarget;
+
+                Thread*             mRenderThread;
+
+                bool                mStopRendering;
+
+                unsigned int        mSubmittedFrame;
 
         };
 
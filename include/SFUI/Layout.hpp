@@ -0,0 +1,333 @@
+#ifndef LAYOUT_HPP_INCLUDED
+#define LAYOUT_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file Layout.hpp
+ * \brief Container widgets arranging their children.
+ * \author Robin Ruaux
+ */
+
+#include <map>
+#include <vector>
+
+#include <SFUI/Widget.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** \class Layout
+         *
+         * \brief The base of the containers arranging their children.
+         *
+         * Layouts work in two passes : the children are measured (see Widget::GetMeasuredSize()), then placed
+         * with Widget::SetLayoutRect(). Measured sizes are cached, so a layout changed by one child only
+         * measures that child again. Hidden children are skipped.
+         *
+         * Resizing a layout doesn't arrange it at once : the children are placed by the next layout pass
+         * (see GuiRenderer::Display()), a single time whatever the number of resizes.
+         *
+         * The children alignment is not used inside a layout.
+         */
+        class Layout : public Widget
+        {
+            public :
+
+                /** \brief Get the space around the children.
+                 *
+                 * \return The padding.
+                 */
+                float                   GetPadding() const;
+
+
+                /** \brief Get the space between two children.
+                 *
+                 * \return The spacing.
+                 */
+                float                   GetSpacing() const;
+
+
+                /** \brief Check if the layout takes its measured size.
+                 *
+                 * \return The fit content property.
+                 */
+                bool                    IsFittingContent() const;
+
+
+                virtual void            LoadStyle(const std::string& style = "");
+
+
+                /** \brief Make the layout take its measured size.
+                 *
+                 * A layout placed by another layout always takes the size given by its parent.
+                 * \param fit True to fit the content, false to keep the size set by SetSize().
+                 */
+                void                    SetFitContent(bool fit = true);
+
+
+                /** \brief Set the space around the children.
+                 *
+                 * \param padding The new padding.
+                 */
+                void                    SetPadding(float padding);
+
+
+                /** \brief Set the space between two children.
+                 *
+                 * \param spacing The new spacing.
+                 */
+                void                    SetSpacing(float spacing);
+
+            protected :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of Layout class.
+                 */
+                Layout();
+
+                /** \brief Place the children in the layout, from their measured size. */
+                virtual void            Arrange() = 0;
+
+                virtual void            OnChange(Widget::Property property);
+
+                virtual void            OnLayout();
+
+            private :
+
+                bool                    mFitContent;
+
+                float                   mPadding;
+
+                float                   mSpacing;
+
+        };
+
+
+        /** \class BoxLayout
+         *
+         * \brief A layout putting its children in a row or a column.
+         */
+        class BoxLayout : public Layout
+        {
+            public :
+
+                typedef enum
+                {
+                    HORIZONTAL,
+                    VERTICAL
+                }   Direction;
+
+
+                /** \brief Get the direction of the children row.
+                 *
+                 * \return The box direction.
+                 */
+                Direction               GetDirection() const;
+
+            protected :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of BoxLayout class.
+                 * \param direction The direction of the children row.
+                 */
+                BoxLayout(Direction direction);
+
+                virtual void            Arrange();
+
+                /** \brief Get the share of the free space given to a child (none by default). */
+                virtual float           GetGrowFactor(const Widget& child) const;
+
+                virtual Vector2f        OnMeasure() const;
+
+                bool                    mStretch;
+
+            private :
+
+                Direction               mDirection;
+
+        };
+
+
+        /** \class HBox
+         *
+         * \brief A layout putting its children from left to right.
+         */
+        class HBox : public BoxLayout
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of HBox class.
+                 */
+                HBox();
+
+        };
+
+
+        /** \class VBox
+         *
+         * \brief A layout putting its children from top to bottom.
+         */
+        class VBox : public BoxLayout
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of VBox class.
+                 */
+                VBox();
+
+        };
+
+
+        /** \class Flex
+         *
+         * \brief A box sharing its free space between its children.
+         *
+         * The space left after the measured sizes is given to the children according to their grow factor,
+         * and the children are stretched to the box breadth.
+         */
+        class Flex : public BoxLayout
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of Flex class.
+                 * \param direction The direction of the children row.
+                 */
+                Flex(Direction direction = HORIZONTAL);
+
+
+                /** \brief Get the grow factor of a child.
+                 *
+                 * \param child The child widget.
+                 * \return The grow factor (0 by default).
+                 */
+                float                   GetGrow(const Widget* child) const;
+
+
+                /** \brief Check if the children are stretched to the box breadth.
+                 *
+                 * \return The stretch property.
+                 */
+                bool                    IsStretched() const;
+
+
+                /** \brief Set the grow factor of a child.
+                 *
+                 * The free space is shared in proportion of the grow factors, children with no factor keep their measured length.
+                 * The factor is forgotten when the child is removed from the box.
+                 * \param child The child widget.
+                 * \param grow The grow factor.
+                 */
+                void                    SetGrow(const Widget* child, float grow);
+
+
+                /** \brief Stretch the children to the box breadth or not.
+                 *
+                 * \param stretch The stretch property.
+                 */
+                void                    SetStretch(bool stretch = true);
+
+            protected :
+
+                virtual float           GetGrowFactor(const Widget& child) const;
+
+                virtual void            OnChildRemoved(const Widget* child);
+
+            private :
+
+                typedef std::map<const Widget*, float>  GrowFactors;
+
+                GrowFactors             mGrowFactors;
+
+        };
+
+
+        /** \class Grid
+         *
+         * \brief A layout putting its children in cells, row after row.
+         *
+         * Each column is as wide as its widest child, each row as high as its highest child.
+         */
+        class Grid : public Layout
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of Grid class.
+                 * \param columns The number of columns.
+                 */
+                Grid(unsigned int columns = 2);
+
+
+                /** \brief Get the number of columns.
+                 *
+                 * \return The number of columns.
+                 */
+                unsigned int            GetColumnCount() const;
+
+
+                virtual void            LoadStyle(const std::string& style = "");
+
+
+                /** \brief Set the number of columns.
+                 *
+                 * \param columns The new number of columns.
+                 */
+                void                    SetColumnCount(unsigned int columns);
+
+            protected :
+
+                virtual void            Arrange();
+
+                virtual Vector2f        OnMeasure() const;
+
+            private :
+
+                mutable std::vector<float>  mColumnWidths;
+
+                unsigned int                mColumns;
+
+                mutable std::vector<float>  mRowHeights;
+
+        };
+
+    }
+
+}
+
+#endif // LAYOUT_HPP_INCLUDED
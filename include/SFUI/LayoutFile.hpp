@@ -0,0 +1,200 @@
+#ifndef LAYOUTFILE_HPP_INCLUDED
+#define LAYOUTFILE_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file LayoutFile.hpp
+ * \brief Widget trees described in xml or binary layout files.
+ * \author Robin Ruaux
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <SFML/Config.hpp>
+#include <SFML/System/Unicode.hpp>
+
+#include <SFUI/Widget.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** \class LayoutFile
+         *
+         * \brief A widget tree described in a layout file.
+         *
+         * In xml layout files, each element of the \<layout\> root is a widget, named by its type, and its
+         * child elements are the widget children :
+         * \code
+         * <layout>
+         *   <Window name="options" style="OptionsWindow" text="Options">
+         *     <VBox style="OptionsBox">
+         *       <CheckBox name="sound" text="Sound" />
+         *       <TextButton name="ok" text="Ok" />
+         *     </VBox>
+         *   </Window>
+         * </layout>
+         * \endcode
+         * The "style" attribute is loaded instead of the default style of the widget, "text" is given to the
+         * widget constructor (caption, title...) and "name" is used to find the widget with FindNode().
+         *
+         * The tree is stored as a flat list of nodes, parents before their children, and can be saved to a binary
+         * layout file loaded without any parsing. Build() creates the whole tree in one pass.
+         */
+        class LayoutFile
+        {
+            public :
+
+                /** \brief Function creating a widget of a registered type.
+                 *
+                 * \param text The "text" attribute of the node.
+                 * \return The widget, created with new.
+                 */
+                typedef Widget* (*Factory)(const Unicode::Text& text);
+
+
+                /** \brief Index value used when a node doesn't exist. */
+                static const Uint32     NoIndex = 0xFFFFFFFF;
+
+
+                /** \brief A widget of the layout. */
+                struct Node
+                {
+                    Uint32  Type;       ///< String offset of the widget type.
+                    Uint32  Name;       ///< String offset of the node name (see FindNode()).
+                    Uint32  Style;      ///< String offset of the widget style.
+                    Uint32  Text;       ///< String offset of the widget text.
+                    Uint32  Parent;     ///< Index of the parent node (NoIndex for the top-level widgets).
+                };
+
+
+                /** \brief Constructor
+                 *
+                 * Constructor of LayoutFile class.
+                 */
+                LayoutFile();
+
+
+                /** \brief Create the widgets of the layout.
+                 *
+                 * The memory of the widgets is reserved at once for each size class, every widget is created and
+                 * added to its parent in a single pass over the nodes. Widgets load the style of their node in their
+                 * constructor (see Widget::SetInitialStyle()), they are styled once. The widgets are created with new
+                 * and belong to the caller.
+                 *
+                 * Widgets have no name : node names are only used to find widgets in the result, the node index
+                 * given by FindNode() is the widget index in \a widgets.
+                 * \param parent The widget receiving the top-level widgets.
+                 * \param widgets Filled with the created widgets, in the node order.
+                 * \return true if every widget type is registered (nothing is created otherwise).
+                 */
+                bool                    Build(Widget& parent, Widgets& widgets) const;
+
+
+                /** \brief Find a node by its name.
+                 *
+                 * \param name The "name" attribute of the node.
+                 * \return The node index (NoIndex if not found), which is also the widget index given by Build().
+                 */
+                Uint32                  FindNode(const std::string& name) const;
+
+
+                /** \brief Get a node.
+                 *
+                 * \param index The node index.
+                 * \return The node.
+                 */
+                const Node&             GetNode(Uint32 index) const;
+
+
+                /** \brief Get the number of nodes.
+                 *
+                 * \return The number of widgets in the layout.
+                 */
+                Uint32                  GetNodeCount() const;
+
+
+                /** \brief Get a string of a node.
+                 *
+                 * \param offset The string offset (see Node).
+                 * \return The null-terminated string.
+                 */
+                const char*             GetString(Uint32 offset) const;
+
+
+                /** \brief Load a binary layout file.
+                 *
+                 * \param filename The name of the binary layout file.
+                 * \return true if the file is a valid layout file.
+                 * \return false otherwise.
+                 */
+                bool                    LoadFromBinary(const std::string& filename);
+
+
+                /** \brief Load an xml layout file.
+                 *
+                 * \param filename The name of the xml layout file.
+                 * \return true if the file has been successfuly loaded.
+                 * \return false otherwise (errors are reported on std::cerr).
+                 */
+                bool                    LoadFromFile(const std::string& filename);
+
+
+                /** \brief Register a widget type.
+                 *
+                 * The built-in widgets are registered by their class name (HSlider and VSlider for the sliders).
+                 * \param type The widget type, used as element name in layout files.
+                 * \param factory The function creating the widgets.
+                 * \param size The size of the widget class, to reserve the widgets memory (0 to allocate them one by one,
+                 * as the classes bigger than the largest size class of the WidgetPool).
+                 */
+                static void             RegisterType(const std::string& type, Factory factory, std::size_t size = 0);
+
+
+                /** \brief Save the layout to a binary layout file.
+                 *
+                 * \param filename The name of the binary layout file.
+                 * \return true if the file has been written.
+                 * \return false otherwise.
+                 */
+                bool                    SaveToBinary(const std::string& filename) const;
+
+            private :
+
+                std::vector<Node>       mNodes;
+
+                std::vector<char>       mStrings;
+
+        };
+    }
+}
+
+#endif // LAYOUTFILE_HPP_INCLUDED
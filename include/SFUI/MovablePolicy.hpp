@@ -43,6 +43,10 @@ namespace sf
         /** \class MovablePolicy
          *
          * \brief Policy for movable, drag and drop (...) widgets's behaviour
+         *
+         * The drag origin and the parent boundaries are taken when the mouse is pressed, each mouse move
+         * then only sets the widget position. The widget alignment is dropped at its first move, so that
+         * a resized parent doesn't align it back, or when a moved ghost is dropped. A click alone keeps it.
          */
         class MovablePolicy : public Policy
         {
@@ -55,6 +59,13 @@ namespace sf
                 MovablePolicy(Widget& widget);
 
 
+                /** \brief Get the color of the ghost outline.
+                 *
+                 * \return The ghost outline color.
+                 */
+                const Color&    GetGhostColor() const;
+
+
                 /** \brief Check if the widget can be blocked.
                  *
                  * \return The widget blocked property.
@@ -62,6 +73,13 @@ namespace sf
                 bool            IsBlocked() const;
 
 
+                /** \brief Check if a ghost outline is dragged instead of the widget.
+                 *
+                 * \return The ghost drag property.
+                 */
+                bool            IsGhostDrag() const;
+
+
                 /** \brief Check if the widget is movable.
                  *
                  * \return The widget movable property.
@@ -95,6 +113,22 @@ namespace sf
                 void            SetBlocked(bool blocked = true);
 
 
+                /** \brief Set the color of the ghost outline.
+                 *
+                 * \param color The ghost outline color.
+                 */
+                void            SetGhostColor(const Color& color);
+
+
+                /** \brief Drag a ghost outline instead of the widget.
+                 *
+                 * The outline follows the mouse and the widget only moves to it when the mouse is released :
+                 * the widget and its children are left untouched during the drag.
+                 * \param ghostDrag The ghost drag property.
+                 */
+                void            SetGhostDrag(bool ghostDrag = true);
+
+
                 /** \brief Set the widget to be movable.
                  *
                  * \param movable The widget movable property.
@@ -125,16 +159,31 @@ namespace sf
 
             private :
 
+                /** \brief End the drag, moving the widget to its last position. */
+                void            Drop();
+
                 bool            mBlocked;
 
                 bool            mDragged;
 
-                Vector2f        mDragOffset;
+                FloatRect       mDragLimits;
+
+                Vector2f        mDragPosition;
+
+                Vector2f        mDragStart;
+
+                Widget          mGhost;
+
+                bool            mGhostDrag;
+
+                Vector2f        mGhostOrigin;
 
                 bool            mMovableX;
                 bool            mMovableY;
 
-                bool            mNeedUpdate;
+                bool            mMoved;
+
+                Vector2f        mStartPosition;
 
         };
     }
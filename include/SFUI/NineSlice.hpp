@@ -0,0 +1,144 @@
+#ifndef NINESLICE_HPP_INCLUDED
+#define NINESLICE_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file NineSlice.hpp
+ * \brief An image drawn as a 3x3 grid of parts.
+ * \author Robin Ruaux
+ */
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+namespace sf
+{
+    class Image;
+
+    namespace ui
+    {
+        /** \class NineSlice
+         *
+         * \brief An image drawn as a 3x3 grid of parts.
+         *
+         * Each part is a subpart of the same image, drawn in a destination rectangle relative to the
+         * slice position. All parts are drawn in a single batch : when the parts form a regular grid
+         * (neighbour parts share their edges, in the image and on screen) the batch is a 16 vertices mesh,
+         * otherwise each part is a separate quad of the batch.
+         *
+         * Parts are indexed by column and row, from 0 to 2. Empty parts are not drawn.
+         */
+        class NineSlice : public Drawable
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of NineSlice class.
+                 */
+                NineSlice();
+
+
+                /** \brief Get the destination rectangle of a part.
+                 *
+                 * \param column The part column.
+                 * \param row The part row.
+                 * \return The rectangle, relative to the slice position.
+                 */
+                const FloatRect&    GetDestRect(unsigned int column, unsigned int row) const;
+
+
+                /** \brief Get the image of the parts.
+                 *
+                 * \return The image, or NULL.
+                 */
+                const Image*        GetImage() const;
+
+
+                /** \brief Get the source rectangle of a part.
+                 *
+                 * \param column The part column.
+                 * \param row The part row.
+                 * \return The subpart of the image, in pixels.
+                 */
+                const IntRect&      GetSourceRect(unsigned int column, unsigned int row) const;
+
+
+                /** \brief Check if the parts form a regular grid.
+                 *
+                 * The check is done once after the parts change, not each time the slice is drawn.
+                 * \return True if the slice is drawn as a 16 vertices mesh.
+                 */
+                bool                IsGrid() const;
+
+
+                /** \brief Set the image of the parts.
+                 *
+                 * \param image The image, or NULL to draw nothing.
+                 */
+                void                SetImage(const Image* image);
+
+
+                /** \brief Set a part.
+                 *
+                 * \param column The part column.
+                 * \param row The part row.
+                 * \param source The subpart of the image, in pixels.
+                 * \param dest The destination rectangle, relative to the slice position.
+                 */
+                void                SetPart(unsigned int column, unsigned int row, const IntRect& source, const FloatRect& dest);
+
+
+            protected :
+
+                virtual void        Render(RenderTarget& target, RenderQueue& queue) const;
+
+
+            private :
+
+                /** \brief Get the grid lines, on screen and in the image. */
+                void                GetGridLines(float* xs, float* ys, int* us, int* vs) const;
+
+                FloatRect           mDestRects[9];
+
+                mutable bool        mGrid;
+
+                mutable bool        mGridChecked;
+
+                const Image*        mImage;
+
+                IntRect             mSourceRects[9];
+
+        };
+
+    }
+
+}
+
+#endif // NINESLICE_HPP_INCLUDED
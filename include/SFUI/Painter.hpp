@@ -0,0 +1,205 @@
+#ifndef PAINTER_HPP_INCLUDED
+#define PAINTER_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file Painter.hpp
+ * \brief Drawing interface used by widgets.
+ * \author Robin Ruaux
+ */
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+#include <SFUI/RectangleMesh.hpp>
+
+namespace sf
+{
+    class Sprite;
+    class String;
+
+    namespace ui
+    {
+        class NineSlice;
+
+        /** \class Painter
+         *
+         * \brief Drawing interface used by widgets.
+         *
+         * Widgets draw themselves with a painter in Widget::OnPaint(). Coordinates are relative to the
+         * painted widget, the painter origin being the widget absolute position.
+         *
+         * SfmlPainter draws with SFML (it is used by Widget::Render()), SoftwarePainter draws into memory,
+         * RecordingPainter records the drawings into a RenderCommandList.
+         */
+        class Painter
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of Painter class.
+                 */
+                Painter()
+                    :   mOpacity(1.f),
+                        mOrigin(0.f, 0.f)
+                {}
+
+
+                /** \brief Destructor
+                 *
+                 * Destructor of Painter class.
+                 */
+                virtual ~Painter()
+                {}
+
+
+                /** \brief Draw a nine-slice image.
+                 *
+                 * \param slice The slice to draw (its position is relative to the origin).
+                 */
+                virtual void        DrawNineSlice(const NineSlice& slice) = 0;
+
+
+                /** \brief Draw a rectangle mesh.
+                 *
+                 * Painters which can't draw the mesh itself fill its rectangle (see FillRect()).
+                 * \param mesh The mesh to draw (its position is relative to the origin).
+                 */
+                virtual void        DrawMesh(const RectangleMesh& mesh)
+                {
+                    const Vector2f& position = mesh.GetPosition();
+                    const Vector2f& size = mesh.GetSize();
+
+                    FillRect(FloatRect(position.x, position.y, position.x + size.x, position.y + size.y),
+                             mesh.GetFillColor(), mesh.GetOutline(), mesh.GetOutlineColor());
+                }
+
+
+                /** \brief Draw a sprite.
+                 *
+                 * \param sprite The sprite to draw (its position is relative to the origin).
+                 */
+                virtual void        DrawSprite(const Sprite& sprite) = 0;
+
+
+                /** \brief Draw a string.
+                 *
+                 * \param string The string to draw (its position is relative to the origin).
+                 */
+                virtual void        DrawString(const String& string) = 0;
+
+
+                /** \brief Fill a rectangle.
+                 *
+                 * Painters draw nothing for a transparent fill or outline.
+                 * \param rect The rectangle to fill.
+                 * \param color The fill color.
+                 * \param outline The outline thickness (0 for no outline).
+                 * \param outlineColor The outline color.
+                 */
+                virtual void        FillRect(const FloatRect& rect, const Color& color, float outline = 0.f, const Color& outlineColor = Color(0, 0, 0, 0)) = 0;
+
+
+                /** \brief Get the opacity applied to the drawings.
+                 *
+                 * \return The opacity, from 0 to 1.
+                 */
+                float               GetOpacity() const
+                {
+                    return mOpacity;
+                }
+
+
+                /** \brief Get the painter origin.
+                 *
+                 * \return The absolute position of the origin.
+                 */
+                const Vector2f&     GetOrigin() const
+                {
+                    return mOrigin;
+                }
+
+
+                /** \brief Restore the clipping area saved by the last PushClip() call.
+                 *
+                 */
+                virtual void        PopClip() = 0;
+
+
+                /** \brief Restrict drawing to a rectangle.
+                 *
+                 * The new clipping area is the intersection of the rectangle and the current area.
+                 * \param rect The clipping rectangle.
+                 */
+                virtual void        PushClip(const FloatRect& rect) = 0;
+
+
+                /** \brief Set the opacity applied to the drawings.
+                 *
+                 * The alpha of every color drawn is multiplied by the opacity (see Widget::SetOpacity()).
+                 * \param opacity The opacity, from 0 to 1.
+                 */
+                void                SetOpacity(float opacity)
+                {
+                    mOpacity = opacity;
+                }
+
+
+                /** \brief Move the painter origin.
+                 *
+                 * \param offset The offset to add to the origin.
+                 */
+                void                Translate(const Vector2f& offset)
+                {
+                    mOrigin += offset;
+                }
+
+
+            protected :
+
+                /** \brief Multiply the alpha of a color by the opacity. */
+                Color               ApplyOpacity(const Color& color) const
+                {
+                    if (mOpacity >= 1.f)
+                        return color;
+                    return Color(color.r, color.g, color.b, static_cast<Uint8>(color.a * mOpacity + 0.5f));
+                }
+
+                float               mOpacity;
+
+                Vector2f            mOrigin;
+
+        };
+
+    }
+
+}
+
+#endif // PAINTER_HPP_INCLUDED
@@ -0,0 +1,322 @@
+#ifndef PROFILER_HPP_INCLUDED
+#define PROFILER_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file Profiler.hpp
+ * \brief Frame timings and per-widget costs of the gui.
+ * \author Robin Ruaux
+ */
+
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace sf
+{
+    namespace ui
+    {
+        class Widget;
+
+        /** \class Profiler
+         *
+         * \brief Frame timings and per-widget costs of the gui.
+         *
+         * When enabled, the gui measures the time spent in its main sections (display, events, rendering,
+         * painting, styles and layout) and counts draw calls, scissor flushes and style reloads.
+         * Each GuiRenderer::Display() call closes a frame, the last frames are kept in a ring buffer.
+         *
+         * Times are exclusive : a section does not include the time spent in the sections it contains,
+         * so the time of a widget does not include its children.
+         *
+         * The profiler is disabled by default, it then only costs a test per instrumented call.
+         */
+        class Profiler
+        {
+            public :
+
+                /** \enum Section
+                 *
+                 * \brief Enumeration of the measured sections.
+                 */
+                typedef enum
+                {
+                    DISPLAY = 0,
+                    INJECT_EVENT,
+                    RENDER,
+                    PAINT,
+                    LOAD_STYLE,
+                    LAYOUT,
+
+                    SECTION_COUNT
+
+                }   Section;
+
+
+                /** \enum Counter
+                 *
+                 * \brief Enumeration of the frame counters.
+                 */
+                typedef enum
+                {
+                    DRAW_CALLS = 0,
+                    SCISSOR_FLUSHES,
+                    STYLE_RELOADS,
+                    FONT_LOADS,
+
+                    COUNTER_COUNT
+
+                }   Counter;
+
+
+                /** \struct Frame
+                 *
+                 * \brief Timings and counters of a frame.
+                 */
+                struct Frame
+                {
+                    float           Time;                       ///< Time since the previous frame, in seconds
+                    float           Sections[SECTION_COUNT];    ///< Time spent in each section, in seconds
+                    unsigned int    Counters[COUNTER_COUNT];    ///< Value of each counter
+                };
+
+
+                /** \struct Entry
+                 *
+                 * \brief Accumulated cost of a widget or a widget type.
+                 */
+                struct Entry
+                {
+                    Entry() : Time(0.f), Calls(0) {}
+
+                    float           Time;                       ///< Time spent, in seconds
+                    unsigned int    Calls;                      ///< Number of measured calls
+                };
+
+
+                /** \typedef std::map<std::string, Entry> TypeEntries
+                 *
+                 * Costs by widget type name (class name, demangled when the compiler allows it).
+                 */
+                typedef std::map<std::string, Entry>    TypeEntries;
+
+
+                /** \typedef std::map<const Widget*, Entry> WidgetEntries
+                 *
+                 * Costs by widget.
+                 */
+                typedef std::map<const Widget*, Entry>  WidgetEntries;
+
+
+                /** Number of frames kept in the ring buffer */
+                static const unsigned int   HistorySize = 120;
+
+
+                /** \brief Start measuring a section.
+                 *
+                 * Prefer a ProfileScope, which ends the section automatically.
+                 * \param section The section to measure.
+                 * \param widget The widget concerned by the section (0 if none).
+                 */
+                static void                 Begin(Section section, const Widget* widget = 0);
+
+
+                /** \brief Add a value to a counter of the current frame.
+                 *
+                 * \param counter The counter.
+                 * \param value The value to add.
+                 */
+                static void                 Count(Counter counter, unsigned int value = 1)
+                {
+                    if (mEnabled)
+                        AddToCounter(counter, value);
+                }
+
+
+                /** \brief Enable or disable the profiler.
+                 *
+                 * \param enable The profiler state.
+                 */
+                static void                 Enable(bool enable = true);
+
+
+                /** \brief Stop measuring the last begun section. */
+                static void                 End();
+
+
+                /** \brief Close the current frame and store it in the ring buffer.
+                 *
+                 * This method is called by GuiRenderer::Display().
+                 */
+                static void                 EndFrame();
+
+
+                /** \brief Export the recorded data in JSON format.
+                 *
+                 * \param filename The name of the file to write.
+                 * \return True if the file has been written.
+                 */
+                static bool                 ExportJson(const std::string& filename);
+
+
+                /** \brief Forget the costs of a widget.
+                 *
+                 * This method is called when a widget is destroyed. It does nothing until a widget
+                 * cost is recorded, so that destroying widgets costs nothing when the profiler is unused.
+                 * \param widget The widget.
+                 */
+                static void                 Forget(const Widget* widget)
+                {
+                    if (mWidgetsRecorded)
+                        ForgetWidget(widget);
+                }
+
+
+                /** \brief Get a recorded frame.
+                 *
+                 * \param age The frame age (0 for the last closed frame).
+                 * \return The frame (must be lower than GetFrameCount()).
+                 */
+                static const Frame&         GetFrame(unsigned int age = 0);
+
+
+                /** \brief Get the number of recorded frames.
+                 *
+                 * \return The number of frames in the ring buffer.
+                 */
+                static unsigned int         GetFrameCount();
+
+
+                /** \brief Get the name of a section.
+                 *
+                 * \param section The section.
+                 * \return The section name.
+                 */
+                static const char*          GetSectionName(Section section);
+
+
+                /** \brief Get the name of a counter.
+                 *
+                 * \param counter The counter.
+                 * \return The counter name.
+                 */
+                static const char*          GetCounterName(Counter counter);
+
+
+                /** \brief Get the accumulated costs by widget type.
+                 *
+                 * \return The costs by widget type.
+                 */
+                static const TypeEntries&   GetTypeEntries();
+
+
+                /** \brief Get the accumulated costs by widget.
+                 *
+                 * \return The costs by widget.
+                 */
+                static const WidgetEntries& GetWidgetEntries();
+
+
+                /** \brief Check if the profiler is enabled.
+                 *
+                 * \return The profiler state.
+                 */
+                static bool                 IsEnabled()
+                {
+                    return mEnabled;
+                }
+
+
+                /** \brief Clear recorded frames and costs. */
+                static void                 Reset();
+
+
+                /** \brief Write the recorded data in JSON format.
+                 *
+                 * \param stream The output stream.
+                 */
+                static void                 WriteJson(std::ostream& stream);
+
+
+            private :
+
+                static void                 AddToCounter(Counter counter, unsigned int value);
+
+                static void                 ForgetWidget(const Widget* widget);
+
+                static bool                 mEnabled;
+
+                static bool                 mWidgetsRecorded;
+
+        };
+
+
+        /** \class ProfileScope
+         *
+         * \brief Measure a Profiler section until the end of the scope.
+         */
+        class ProfileScope
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Begin the section if the profiler is enabled.
+                 * \param section The section to measure.
+                 * \param widget The widget concerned by the section (0 if none).
+                 */
+                ProfileScope(Profiler::Section section, const Widget* widget = 0)
+                    :   mActive(Profiler::IsEnabled())
+                {
+                    if (mActive)
+                        Profiler::Begin(section, widget);
+                }
+
+
+                /** \brief Destructor
+                 *
+                 * End the section.
+                 */
+                ~ProfileScope()
+                {
+                    if (mActive)
+                        Profiler::End();
+                }
+
+            private :
+
+                bool                mActive;
+
+        };
+
+    }
+
+}
+
+#endif // PROFILER_HPP_INCLUDED
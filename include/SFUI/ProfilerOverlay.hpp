@@ -0,0 +1,111 @@
+#ifndef PROFILEROVERLAY_HPP_INCLUDED
+#define PROFILEROVERLAY_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file ProfilerOverlay.hpp
+ * \brief Widget showing the Profiler measures.
+ * \author Robin Ruaux
+ */
+
+#include <SFML/Graphics/String.hpp>
+
+#include <SFUI/Widget.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** \class ProfilerOverlay
+         *
+         * \brief Widget showing the Profiler measures.
+         *
+         * The overlay shows the frame time and the section times averaged over the last frames,
+         * the counters of the last frame and the most expensive widget types.
+         *
+         * It does not enable the Profiler, see Profiler::Enable().
+         */
+        class ProfilerOverlay : public Widget
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of ProfilerOverlay class.
+                 */
+                ProfilerOverlay();
+
+
+                /** \brief Get the number of frames used to average times.
+                 *
+                 * \return The number of frames.
+                 */
+                unsigned int            GetAveragedFrames() const;
+
+
+                /** \brief Load a new style for the overlay.
+                 *
+                 * \param nameStyle The style string value to load.
+                 */
+                virtual void            LoadStyle(const std::string& nameStyle);
+
+
+                /** \brief Set the number of frames used to average times.
+                 *
+                 * \param frames The number of frames (between 1 and Profiler::HistorySize).
+                 */
+                void                    SetAveragedFrames(unsigned int frames);
+
+
+                /** \brief Set the number of widget types shown.
+                 *
+                 * \param count The number of widget types.
+                 */
+                void                    SetShownTypes(unsigned int count);
+
+
+            protected :
+
+                virtual void            OnPaint(Painter& painter) const;
+
+            private :
+
+                unsigned int            mAveragedFrames;
+
+                unsigned int            mShownTypes;
+
+                mutable String          mText;
+
+        };
+
+    }
+
+}
+
+#endif // PROFILEROVERLAY_HPP_INCLUDED
@@ -0,0 +1,168 @@
+#ifndef RASTERKERNELS_HPP_INCLUDED
+#define RASTERKERNELS_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file RasterKernels.hpp
+ * \brief Pixel span operations of the software renderer.
+ * \author Robin Ruaux
+ */
+
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Color.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** \namespace Raster
+         *
+         * \brief Pixel span operations of the software renderer.
+         *
+         * Pixels are 32 bits RGBA values, with the byte order of sf::Image (red first in memory),
+         * and premultiplied alpha : color channels are already multiplied by the alpha.
+         * Blending is "source over" : dst = src + dst * (1 - src.a), on all channels.
+         *
+         * Each operation has a scalar, a SSE2 and an AVX2 version. The best version supported by
+         * the processor is selected at runtime, and all versions give exactly the same results.
+         */
+        namespace Raster
+        {
+            /** \brief Instruction sets of the kernels. */
+            enum Kernels
+            {
+                SCALAR, /**< Portable C++ */
+                SSE2,   /**< 4 pixels at a time */
+                AVX2    /**< 8 pixels at a time */
+            };
+
+
+            /** \brief Blend a color over a span of pixels, with a coverage per pixel.
+             *
+             * Used to draw glyphs : the coverage is the glyph alpha.
+             * \param dst The destination pixels.
+             * \param mask The coverage of each pixel, from 0 to 255.
+             * \param count The number of pixels.
+             * \param color The packed source color.
+             */
+            void        BlendMask(Uint32* dst, const Uint8* mask, unsigned int count, Uint32 color);
+
+
+            /** \brief Blend source pixels, modulated by a color, over a span of pixels.
+             *
+             * \param dst The destination pixels.
+             * \param src The premultiplied source pixels.
+             * \param count The number of pixels.
+             * \param modulate The packed color multiplied with the source pixels.
+             */
+            void        BlendPixels(Uint32* dst, const Uint32* src, unsigned int count, Uint32 modulate);
+
+
+            /** \brief Blend a constant color over a span of pixels.
+             *
+             * \param dst The destination pixels.
+             * \param count The number of pixels.
+             * \param color The packed source color.
+             */
+            void        BlendSpan(Uint32* dst, unsigned int count, Uint32 color);
+
+
+            /** \brief Fill a span of pixels with a color.
+             *
+             * \param dst The destination pixels.
+             * \param count The number of pixels.
+             * \param color The packed color.
+             */
+            void        FillSpan(Uint32* dst, unsigned int count, Uint32 color);
+
+
+            /** \brief Get the name of the kernels in use.
+             *
+             * \return "scalar", "sse2" or "avx2".
+             */
+            const char* GetKernelName();
+
+
+            /** \brief Get the kernels in use.
+             *
+             * \return The instruction set of the kernels.
+             */
+            Kernels     GetKernels();
+
+
+            /** \brief Pack a color to a premultiplied pixel.
+             *
+             * \param color The color.
+             * \return The packed pixel.
+             */
+            Uint32      PackColor(const Color& color);
+
+
+            /** \brief Convert straight alpha pixels, like sf::Image ones, to premultiplied alpha.
+             *
+             * \param pixels The pixels to convert.
+             * \param count The number of pixels.
+             */
+            void        Premultiply(Uint32* pixels, unsigned int count);
+
+
+            /** \brief Copy source pixels with a fixed point step (nearest neighbour scaling).
+             *
+             * dst[i] = src[(position + i * step) >> 16]
+             * \param dst The destination pixels.
+             * \param src The source row.
+             * \param count The number of destination pixels.
+             * \param position The 16.16 fixed point position of the first pixel in the source.
+             * \param step The 16.16 fixed point distance between two pixels in the source.
+             */
+            void        ScalePixels(Uint32* dst, const Uint32* src, unsigned int count, Uint32 position, Uint32 step);
+
+
+            /** \brief Force the kernels in use.
+             *
+             * Mostly useful to compare the instruction sets.
+             * \param kernels The instruction set.
+             * \return False if the processor doesn't support it, the kernels are unchanged.
+             */
+            bool        SetKernels(Kernels kernels);
+
+
+            /** \brief Convert premultiplied pixels back to straight alpha.
+             *
+             * \param pixels The pixels to convert.
+             * \param count The number of pixels.
+             */
+            void        Unpremultiply(Uint32* pixels, unsigned int count);
+        }
+
+    }
+
+}
+
+#endif // RASTERKERNELS_HPP_INCLUDED
@@ -0,0 +1,138 @@
+#ifndef RECTANGLEMESH_HPP_INCLUDED
+#define RECTANGLEMESH_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file RectangleMesh.hpp
+ * \brief A filled and outlined rectangle with persistent geometry.
+ * \author Robin Ruaux
+ */
+
+#include <SFML/Graphics/Drawable.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** \class RectangleMesh
+         *
+         * \brief A filled and outlined rectangle with persistent geometry.
+         *
+         * Unlike sf::Shape::Rectangle(), the mesh doesn't allocate memory : its vertices are stored
+         * in the object and only computed again when the size or the outline changes. The rectangle
+         * starts at the drawable position and the outline is drawn outside, like sf::Shape does.
+         *
+         * Colors are vertex colors, the drawable color modulates them. A white mesh of size 1x1 can be
+         * shared by many rectangles, each one being set with SetPosition(), SetScale() and SetColor().
+         */
+        class RectangleMesh : public Drawable
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * \param size The rectangle size.
+                 * \param fillColor The fill color.
+                 * \param outline The outline thickness.
+                 * \param outlineColor The outline color.
+                 */
+                RectangleMesh(const Vector2f& size = Vector2f(1.f, 1.f), const Color& fillColor = Color(255, 255, 255),
+                              float outline = 0.f, const Color& outlineColor = Color(0, 0, 0, 0));
+
+
+                /** \brief Get the fill color.
+                 *
+                 * \return The fill color.
+                 */
+                const Color&        GetFillColor() const;
+
+
+                /** \brief Get the outline thickness.
+                 *
+                 * \return The outline thickness.
+                 */
+                float               GetOutline() const;
+
+
+                /** \brief Get the outline color.
+                 *
+                 * \return The outline color.
+                 */
+                const Color&        GetOutlineColor() const;
+
+
+                /** \brief Get the rectangle size.
+                 *
+                 * \return The rectangle size.
+                 */
+                const Vector2f&     GetSize() const;
+
+
+                /** \brief Set the colors.
+                 *
+                 * A transparent color disables the matching part of the mesh.
+                 * \param fillColor The fill color.
+                 * \param outlineColor The outline color.
+                 */
+                void                SetColors(const Color& fillColor, const Color& outlineColor);
+
+
+                /** \brief Set the rectangle geometry.
+                 *
+                 * Nothing is computed when the geometry is unchanged.
+                 * \param size The rectangle size.
+                 * \param outline The outline thickness.
+                 */
+                void                SetGeometry(const Vector2f& size, float outline);
+
+
+            protected :
+
+                virtual void        Render(RenderTarget& target, RenderQueue& queue) const;
+
+
+            private :
+
+                Color               mFillColor;
+
+                float               mOutline;
+
+                Color               mOutlineColor;
+
+                Vector2f            mPoints[8];
+
+                Vector2f            mSize;
+
+        };
+
+    }
+
+}
+
+#endif // RECTANGLEMESH_HPP_INCLUDED
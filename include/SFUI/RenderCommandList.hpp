@@ -0,0 +1,215 @@
+#ifndef RENDERCOMMANDLIST_HPP_INCLUDED
+#define RENDERCOMMANDLIST_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file RenderCommandList.hpp
+ * \brief Recorded drawings of a frame, replayed later by SFML.
+ * \author Robin Ruaux
+ */
+
+#include <vector>
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/String.hpp>
+
+#include <SFUI/DistanceFieldText.hpp>
+#include <SFUI/NineSlice.hpp>
+#include <SFUI/Painter.hpp>
+#include <SFUI/RectangleMesh.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        class Widget;
+
+        /** \class RenderCommandList
+         *
+         * \brief Recorded drawings of a frame, replayed later by SFML.
+         *
+         * A RecordingPainter fills the list with copies of everything it needs (sprites, strings,
+         * colors, absolute rectangles), so drawing the list doesn't read any widget or resource
+         * manager state. The list can thus be drawn by another thread while widgets are updated.
+         *
+         * Drawing the list replays the commands in order, the clipping rectangles are applied with
+         * the scissor test. Clearing the list keeps its memory for the next frame.
+         */
+        class RenderCommandList : public Drawable
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of RenderCommandList class.
+                 */
+                RenderCommandList();
+
+
+                /** \brief Remove all the commands.
+                 *
+                 */
+                void                Clear();
+
+
+                /** \brief Get the number of recorded commands.
+                 *
+                 * \return The number of commands.
+                 */
+                unsigned int        GetCommandCount() const;
+
+
+                /** \brief Record a widget and its children.
+                 *
+                 * The list is cleared first.
+                 * \param widget The widget to record.
+                 */
+                void                Record(const Widget& widget);
+
+
+            protected :
+
+                /** \brief Replay the commands. */
+                virtual void        Render(RenderTarget& target, RenderQueue& queue) const;
+
+
+            private :
+
+                friend class RecordingPainter;
+
+                enum CommandType
+                {
+                    FILL_RECT,
+                    DRAW_NINE_SLICE,
+                    DRAW_SPRITE,
+                    DRAW_STRING,
+                    DRAW_TEXT,
+                    PUSH_CLIP,
+                    POP_CLIP
+                };
+
+                /** A recorded call, drawables are stored in the arrays of their type */
+                struct Command
+                {
+                    CommandType     Type;
+                    unsigned int    Index;
+                    FloatRect       Rect;
+                    Color           FillColor;
+                    float           Outline;
+                    Color           OutlineColor;
+                };
+
+                /** \brief Set the scissor test to the current clipping rectangle, then flush the queue. */
+                void                Flush(RenderTarget& target, RenderQueue& queue) const;
+
+                mutable std::vector<FloatRect>  mClips;
+
+                std::vector<Command>            mCommands;
+
+                mutable RectangleMesh           mMesh;
+
+                unsigned int                    mSliceCount;
+
+                std::vector<NineSlice>          mSlices;
+
+                unsigned int                    mSpriteCount;
+
+                std::vector<Sprite>             mSprites;
+
+                unsigned int                    mStringCount;
+
+                std::vector<String>             mStrings;
+
+                unsigned int                    mTextCount;
+
+                std::vector<DistanceFieldText>  mTexts;
+
+                mutable RectangleMesh           mUnitQuad;
+
+        };
+
+
+        /** \class RecordingPainter
+         *
+         * \brief Painter recording its calls into a RenderCommandList.
+         *
+         * Positions and clipping rectangles are recorded in absolute coordinates. Scaled strings
+         * are laid out with the distance field of their font while recording.
+         */
+        class RecordingPainter : public Painter
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * \param list The list to record into.
+                 */
+                RecordingPainter(RenderCommandList& list);
+
+
+                /** \brief Record a copy of the slice. */
+                virtual void        DrawNineSlice(const NineSlice& slice);
+
+
+                /** \brief Record a copy of the sprite. */
+                virtual void        DrawSprite(const Sprite& sprite);
+
+
+                /** \brief Record a copy of the string, or its distance field glyphs when it is scaled. */
+                virtual void        DrawString(const String& string);
+
+
+                /** \brief Record the rectangle and its colors. */
+                virtual void        FillRect(const FloatRect& rect, const Color& color, float outline = 0.f, const Color& outlineColor = Color(0, 0, 0, 0));
+
+
+                /** \brief Record the end of the clipping area. */
+                virtual void        PopClip();
+
+
+                /** \brief Record the clipping area, intersected with the current one. */
+                virtual void        PushClip(const FloatRect& rect);
+
+
+            private :
+
+                RenderCommandList::Command&     AddCommand(RenderCommandList::CommandType type);
+
+                std::vector<FloatRect>          mClips;
+
+                RenderCommandList&              mList;
+
+        };
+
+    }
+
+}
+
+#endif // RENDERCOMMANDLIST_HPP_INCLUDED
@@ -1,6 +1,6 @@
-#ifndef RESOURCEMANAGER_HPP_INCLUDED
-#define RESOURCEMANAGER_HPP_INCLUDED
-
+#ifndef RESOURCEMANAGER_HPP_INCLUDED
+#define RESOURCEMANAGER_HPP_INCLUDED
+
 /*
     Copyright (c) 2009, Robin RUAUX
     All rights reserved.
@@ -34,23 +34,31 @@
  * \author Robin Ruaux
  */
 
+#include <cstddef>
 #include <string>
 #include <map>
+#include <set>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/System/Clock.hpp>
 
 #include <SFUI/Area.hpp>
+#include <SFUI/GlyphAtlas.hpp>
 
 namespace sf
 {
     class Color;
     class Font;
     class Image;
-    class Sprite;
 
     namespace ui
     {
+        class DistanceFieldFont;
+        class Widget;
 
         /** \typedef std::map<std::string, Font*> Fonts;
          *
@@ -73,6 +81,13 @@ namespace sf
         typedef std::map<std::string, Image*>               Images;
 
 
+        /** \typedef std::map<std::string, Sprite> Sprites;
+         *
+         * Container for resolved image strings (sub-rects included).
+         */
+        typedef std::map<std::string, Sprite>               Sprites;
+
+
         /** \typedef std::map<std::string, std::string> StyleProperties
          *
          * Widget style properties with syntax property["name"] = "value".
@@ -87,6 +102,41 @@ namespace sf
         typedef std::map<std::string, StyleProperties>      Styles;
 
 
+        /** \typedef std::map<std::string, std::set<Widget*> > StyleUsers
+         *
+         * Reverse index of styles : widgets using each style.
+         */
+        typedef std::map<std::string, std::set<Widget*> >   StyleUsers;
+
+
+        /** \struct PreloadStats
+         *
+         * \brief Timings and counters reported by ResourceManager::Preload() and ResourceManager::SwitchTheme().
+         *
+         * All times are expressed in seconds.
+         */
+        struct PreloadStats
+        {
+            PreloadStats()
+                :   ParseTime(0.f), ReadTime(0.f), FontTime(0.f), ImageTime(0.f), StyleTime(0.f), TotalTime(0.f),
+                    FontCount(0), ImageCount(0), SubRectCount(0), FailureCount(0), WidgetCount(0)
+            {}
+
+            float           ParseTime;  ///< Time spent reading the style file.
+            float           ReadTime;   ///< Time spent reading resource files from disk (in parallel).
+            float           FontTime;   ///< Time spent creating fonts.
+            float           ImageTime;  ///< Time spent decoding images and resolving sub-rects.
+            float           StyleTime;  ///< Time spent restyling widgets (SwitchTheme() only).
+            float           TotalTime;  ///< Total time of the preload pass.
+
+            unsigned int    FontCount;      ///< Number of fonts loaded.
+            unsigned int    ImageCount;     ///< Number of images loaded.
+            unsigned int    SubRectCount;   ///< Number of sub-rects resolved ("sub:" image strings).
+            unsigned int    FailureCount;   ///< Number of resources which could not be loaded.
+            unsigned int    WidgetCount;    ///< Number of widgets restyled (SwitchTheme() only).
+        };
+
+
         /** \class ResourceManager
          *
          * \brief Utility class for managing widget resources.
@@ -118,6 +168,33 @@ namespace sf
                 bool                        AddStylesFromFile(const std::string& filename);
 
 
+                /** \brief Add new styles and resources from a precompiled skin file.
+                 *
+                 * Skin files are built from xml style files with SkinFile::Compile() (or the sfui-skinc tool).
+                 * The file is memory-mapped and read in place, no xml parsing is involved.
+                 * \param filename The name of the skin file to load.
+                 * \return true if file has been successfuly loaded.
+                 * \return false otherwise.
+                 */
+                bool                        AddStylesFromSkin(const std::string& filename);
+
+
+                /** \brief Watch loaded style files and re-apply their styles when they change.
+                 *
+                 * Files loaded with AddStylesFromFile() are watched (with inotify on Linux, by checking
+                 * their modification time on other systems). Changes are applied by ReloadChangedStyles().
+                 * \param enable Enable or disable hot reload.
+                 */
+                void                        EnableHotReload(bool enable = true);
+
+
+                /** \brief Check if style files are watched.
+                 *
+                 * \return The hot reload state.
+                 */
+                bool                        IsHotReloadEnabled() const;
+
+
                 /** \brief Get a property color value from its string value.
                  *
                  * Color string value could be represented as different syntaxes :
@@ -146,11 +223,26 @@ namespace sf
                  </resources>
                  * \endcode </li></ul>
                  *
+                 * Fonts are cached by file and size : a font file or alias requested at a new size is loaded
+                 * again at that size, and aliases of the same file and size share one font.
+                 *
                  * \param filename The font string value.
-                 * \param size The font size.
+                 * \param size The font size (0 for the size declared by the alias, 30 for a font file).
                  * \return The loaded font (0 if failed).
                  */
-                Font*                       GetFont(const std::string& filename, float size = 30.f);
+                Font*                       GetFont(const std::string& filename, float size = 0.f);
+
+
+                /** \brief Get the distance field of a font, to draw it at any size.
+                 *
+                 * The distance field is generated the first time it is requested, and shared by all
+                 * the fonts loaded from the same file, whatever their size. The glyphs of all distance
+                 * fields are rasterized into one shared atlas.
+                 *
+                 * \param font A font loaded by the resource manager.
+                 * \return The distance field font (0 if the font file is unknown or could not be loaded).
+                 */
+                DistanceFieldFont*          GetDistanceField(const Font& font);
 
                 /** \brief Get an image from its string value
                  *
@@ -171,6 +263,28 @@ namespace sf
                 Sprite                      GetImage(const std::string& name);
 
 
+                /** \brief Re-apply the styles of watched files which have changed.
+                 *
+                 * This method is called by GuiRenderer::Display() at the beginning of each frame.
+                 * It does nothing if hot reload isn't enabled.
+                 * \return The number of widgets whose style has been reloaded.
+                 */
+                unsigned int                ReloadChangedStyles();
+
+
+                /** \brief Reload a style file and re-apply the styles which have changed.
+                 *
+                 * The new styles are compared to the old ones. Only widgets using a changed style,
+                 * or a style inheriting from a changed one (through "from"), load their style again.
+                 *
+                 * New resource aliases are loaded, and redefined aliases are loaded again from their new file :
+                 * widgets using them through a style are restyled too.
+                 * \param filename The name of the style file.
+                 * \return The number of widgets whose style has been reloaded.
+                 */
+                unsigned int                ReloadStylesFromFile(const std::string& filename);
+
+
                 /** \brief Get a style from memory.
                  *
                  * \param name The style name to load.
@@ -179,6 +293,40 @@ namespace sf
                 StyleProperties&            GetStyle(const std::string& name);
 
 
+                /** \brief Load a style file and resolve all its resources up front.
+                 *
+                 * Styles are added like AddStylesFromFile() does, then every font and image
+                 * referenced by a style (aliases, files and "sub:" strings) is loaded.
+                 * Files are read from disk by several threads, while fonts and images are created
+                 * on the calling thread, which must own the rendering context.
+                 *
+                 * Call it from a loading screen to keep file accesses out of widget construction.
+                 * \param filename The name of the style file to load.
+                 * \param stats Optional structure filled with the preload timings.
+                 * \return true if the style file has been successfuly loaded.
+                 * \return false otherwise.
+                 */
+                bool                        Preload(const std::string& filename, PreloadStats* stats = 0);
+
+
+                /** \brief Switch to the styles of a theme file, and restyle the widgets using them.
+                 *
+                 * The styles of the file replace the current styles of the same name, and their resources
+                 * are loaded like Preload() does. Resource aliases defined with another file or size are replaced,
+                 * and the widgets using them through a style are restyled.
+                 *
+                 * Styles are compared, and the widgets to restyle are resolved, on several threads : this
+                 * pass only reads the styles and the widget hierarchy. Widgets are then restyled by one pass
+                 * on the calling thread, each widget once (parts are restyled by their parent).
+                 *
+                 * \param filename The name of the theme style file.
+                 * \param stats Optional structure filled with the timings.
+                 * \return true if the theme file has been successfuly loaded.
+                 * \return false otherwise.
+                 */
+                bool                        SwitchTheme(const std::string& filename, PreloadStats* stats = 0);
+
+
                 /** \brief Get a property value from its string value.
                  *
                  * \param value The property value to be converted.
@@ -196,28 +344,154 @@ namespace sf
                     return (retValue = defaultValue);
                 }
 
+
+                /** \brief Get a boolean property value from its string value.
+                 *
+                 * During a restyle, values parsed beforehand are taken from a cache (see SwitchTheme()).
+                 * \param value The property value to be converted.
+                 * \param defaultValue The property value to be returned if conversion failed.
+                 * \return The property value.
+                 */
+                bool        GetValue(const std::string& value, const bool& defaultValue);
+
+
+                /** \brief Get a float property value from its string value.
+                 *
+                 * During a restyle, values parsed beforehand are taken from a cache (see SwitchTheme()).
+                 * \param value The property value to be converted.
+                 * \param defaultValue The property value to be returned if conversion failed.
+                 * \return The property value.
+                 */
+                float       GetValue(const std::string& value, const float& defaultValue);
+
+
+                /** \brief Get an integer property value from its string value.
+                 *
+                 * During a restyle, values parsed beforehand are taken from a cache (see SwitchTheme()).
+                 * \param value The property value to be converted.
+                 * \param defaultValue The property value to be returned if conversion failed.
+                 * \return The property value.
+                 */
+                int         GetValue(const std::string& value, const int& defaultValue);
+
                 mutable Area                WidgetArea;
 
             private :
 
+                friend class _StyleLoader;
+
+                friend class Widget;
+
+                /** Styles defined by a loaded style file */
+                struct StyleFile
+                {
+                    StyleFile() : ModificationTime(0) {}
+
+                    std::set<std::string>   Names;
+
+                    long                    ModificationTime;
+                };
+
+                typedef std::map<std::string, StyleFile>    StyleFiles;
+
+                /** A style value parsed once for all the widgets of a restyle */
+                struct ParsedValue
+                {
+                    ParsedValue() : Bool(false), Float(0.f), Int(0), HasBool(false), HasColor(false), HasFloat(false), HasInt(false) {}
+
+                    bool                    Bool;
+
+                    Color                   ColorValue;
+
+                    float                   Float;
+
+                    int                     Int;
+
+                    bool                    HasBool;
+
+                    bool                    HasColor;
+
+                    bool                    HasFloat;
+
+                    bool                    HasInt;
+                };
+
+                typedef std::map<std::string, ParsedValue>  ParsedValues;
+
+                /** Values parsed by the task pool, with the strings they come from */
+                struct ParsePass
+                {
+                    ResourceManager*            Manager;
+
+                    std::vector<std::string>    Values;
+
+                    std::vector<ParsedValue>    Parsed;
+                };
+
                 ResourceManager();
 
                 ~ResourceManager();
 
+                unsigned int                ApplyChangedStyles(const std::set<std::string>& changed);
+
+                bool                        IsStyleAffected(const std::string& name, const std::set<std::string>& changed) const;
+
                 bool                        LoadFont(const std::string& resId, const std::string& filename, float size = 30.f);
 
+                Font*                       LoadFontFile(const std::string& filename, float size);
+
+                std::pair<std::string, unsigned int>    ResolveFont(const std::string& name, float size) const;
+
+                void                        LoadStyleResources(PreloadStats& result);
+
                 bool                        LoadImage(const std::string& resId, const std::string& filename);
 
+                bool                        ParseColor(const std::string& value, Color& color);
+
+                static void                 ParseStyleValue(void* userData, std::size_t index);
+
+                void                        SetStyleUser(Widget* widget, const std::string& oldStyle, const std::string& newStyle);
+
+                void                        WatchStyleFile(const std::string& filename);
+
+                bool                        mHotReload;
+
+                int                         mNotifyFd;
+
+                Clock                       mPollClock;
+
+                StyleFiles                  mStyleFiles;
+
+                StyleUsers                  mStyleUsers;
+
+                std::map<int, std::string>  mWatchedDirs;
+
+                std::map<std::string, DistanceFieldFont*>   mDistanceFields;
+
+                std::map<std::string, std::pair<std::string, float> >  mFontAliases;
+
+                std::map<std::pair<std::string, unsigned int>, Font*>  mFontCache;
+
+                std::map<const Font*, std::string>          mFontFiles;
+
+                std::map<std::string, std::string>          mImageFiles;
+
                 Fonts                       mFonts;
 
+                GlyphAtlas                  mGlyphAtlas;
+
                 Images                      mImages;
 
+                ParsedValues                mParsedValues;
+
+                Sprites                     mSprites;
+
                 static  ResourceManager*    mInstance;
 
                 Styles                      mStyles;
 
         };
     }
-}
-
-#endif // RESOURCEMANAGER_HPP_INCLUDED
+}
+
+#endif // RESOURCEMANAGER_HPP_INCLUDED
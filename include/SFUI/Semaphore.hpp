@@ -0,0 +1,96 @@
+#ifndef SEMAPHORE_HPP_INCLUDED
+#define SEMAPHORE_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file Semaphore.hpp
+ * \brief A counting semaphore, to block threads until there is something to do.
+ * \author Robin Ruaux
+ */
+
+namespace sf
+{
+    namespace ui
+    {
+        /** \class Semaphore
+         *
+         * \brief A counting semaphore, to block threads until there is something to do.
+         *
+         * Wait() blocks while the count is 0, then decrements it. Post() increments the count and
+         * wakes one waiting thread. SFML has no condition variable : threads waiting for each other
+         * use a semaphore instead of polling with sf::Sleep().
+         */
+        class Semaphore
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of Semaphore class.
+                 * \param count The initial count.
+                 */
+                explicit Semaphore(unsigned int count = 0);
+
+
+                /** \brief Destructor
+                 *
+                 * Destructor of Semaphore class. No thread may be waiting.
+                 */
+                ~Semaphore();
+
+
+                /** \brief Increment the count, waking one waiting thread.
+                 *
+                 */
+                void                Post();
+
+
+                /** \brief Wait until the count is positive, then decrement it.
+                 *
+                 */
+                void                Wait();
+
+
+            private :
+
+                struct Data;
+
+                Semaphore(const Semaphore&);
+
+                Semaphore&          operator=(const Semaphore&);
+
+                Data*               mData;
+
+        };
+
+    }
+
+}
+
+#endif // SEMAPHORE_HPP_INCLUDED
@@ -0,0 +1,153 @@
+#ifndef SFMLPAINTER_HPP_INCLUDED
+#define SFMLPAINTER_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file SfmlPainter.hpp
+ * \brief Painter drawing with SFML.
+ * \author Robin Ruaux
+ */
+
+#include <vector>
+
+#include <SFML/Graphics/Drawable.hpp>
+
+#include <SFUI/DistanceFieldText.hpp>
+#include <SFUI/Painter.hpp>
+#include <SFUI/RectangleMesh.hpp>
+
+namespace sf
+{
+    class RenderQueue;
+    class RenderTarget;
+
+    namespace ui
+    {
+        /** \class SfmlPainter
+         *
+         * \brief Painter drawing with SFML.
+         *
+         * This painter is created by Widget::Render(), which paints the whole widget tree with it. The target
+         * is transformed for the rendered widget only : the drawings of the other widgets are moved by the
+         * painter origin. Clipping areas are applied with the scissor test when the queue is flushed.
+         */
+        class SfmlPainter : public Painter
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * \param target The render target.
+                 * \param queue The render queue of the target.
+                 * \param origin The absolute position matching the current transformation of the target.
+                 */
+                SfmlPainter(RenderTarget& target, RenderQueue& queue, const Vector2f& origin = Vector2f(0.f, 0.f));
+
+
+                /** \brief Destructor
+                 *
+                 * Drawings queued after the last clipping area are flushed without scissor test.
+                 */
+                virtual ~SfmlPainter();
+
+
+                /** \brief Draw a rectangle mesh with the target, in one batch. */
+                virtual void        DrawMesh(const RectangleMesh& mesh);
+
+
+                /** \brief Draw a nine-slice image with the target, in one batch. */
+                virtual void        DrawNineSlice(const NineSlice& slice);
+
+
+                /** \brief Draw a sprite with the target. */
+                virtual void        DrawSprite(const Sprite& sprite);
+
+
+                /** \brief Draw a string with the target, from the distance field of its font when it is scaled. */
+                virtual void        DrawString(const String& string);
+
+
+                /** \brief Draw a rectangle mesh with the target, without memory allocation. */
+                virtual void        FillRect(const FloatRect& rect, const Color& color, float outline = 0.f, const Color& outlineColor = Color(0, 0, 0, 0));
+
+
+                /** \brief Flush the queued drawings with the scissor test of the clipping area, then restore the previous area. */
+                virtual void        PopClip();
+
+
+                /** \brief Flush the queued drawings and restrict the next ones to a clipping area. */
+                virtual void        PushClip(const FloatRect& rect);
+
+
+            private :
+
+                /** Drawable moved by the painter origin, drawing another drawable */
+                class Translation : public Drawable
+                {
+                    public :
+
+                        const Drawable*     Inner;
+
+                    protected :
+
+                        virtual void        Render(RenderTarget& target, RenderQueue& queue) const;
+
+                };
+
+                /** \brief Draw a drawable, moved from the target transformation to the origin. */
+                void                Draw(const Drawable& drawable);
+
+                /** \brief Set the scissor test to the current clipping area, then flush the queue. */
+                void                Flush();
+
+                Vector2f                mBase;
+
+                std::vector<FloatRect>  mClips;
+
+                bool                    mClipped;
+
+                RectangleMesh           mMesh;
+
+                RenderQueue&            mQueue;
+
+                RenderTarget&           mTarget;
+
+                DistanceFieldText       mText;
+
+                Translation             mTranslation;
+
+                RectangleMesh           mUnitQuad;
+
+        };
+
+    }
+
+}
+
+#endif // SFMLPAINTER_HPP_INCLUDED
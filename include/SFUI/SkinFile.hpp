@@ -0,0 +1,237 @@
+#ifndef SKINFILE_HPP_INCLUDED
+#define SKINFILE_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file SkinFile.hpp
+ * \brief Precompiled binary style files.
+ * \author Robin Ruaux
+ */
+
+#include <string>
+#include <vector>
+
+#include <SFML/Config.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** \class SkinFile
+         *
+         * \brief Precompiled binary style files.
+         *
+         * A skin file holds the styles and resources of an xml style file in a compact binary form :
+         * <ul>
+         * <li>every string (names, property keys and values, file names) is stored once in a string table,</li>
+         * <li>styles are sorted by name and their "from" inheritance is resolved to a style index,</li>
+         * <li>all records are fixed-size, so the file is used in place once memory-mapped.</li>
+         * </ul>
+         *
+         * Skin files are produced with SkinFile::Compile() (see the sfui-skinc tool)
+         * and loaded with ResourceManager::AddStylesFromSkin().
+         */
+        class SkinFile
+        {
+            public :
+
+                /** \brief Index value used when a reference doesn't exist. */
+                static const Uint32     NoIndex = 0xFFFFFFFF;
+
+
+                /** \brief Type of a declared resource. */
+                typedef enum
+                {
+                    FONT = 0,
+                    IMAGE
+                }   ResourceType;
+
+
+                /** \brief A style record. */
+                struct Style
+                {
+                    Uint32  Name;           ///< String index of the style name.
+                    Uint32  FirstProperty;  ///< Index of the first property of the style.
+                    Uint32  PropertyCount;  ///< Number of properties.
+                    Uint32  Parent;         ///< Style index of the "from" style (NoIndex if none).
+                };
+
+
+                /** \brief A style property record. */
+                struct Property
+                {
+                    Uint32  Key;            ///< String index of the property name.
+                    Uint32  Value;          ///< String index of the property value.
+                };
+
+
+                /** \brief A declared resource record. */
+                struct Resource
+                {
+                    Uint32  Type;           ///< ResourceType of the resource.
+                    Uint32  Name;           ///< String index of the resource alias.
+                    Uint32  Source;         ///< String index of the resource file.
+                    float   Size;           ///< Font size (unused by images).
+                };
+
+
+                /** \brief Constructor
+                 *
+                 * Constructor of SkinFile class.
+                 */
+                SkinFile();
+
+
+                /** \brief Destructor
+                 *
+                 * The file is unmapped.
+                 */
+                ~SkinFile();
+
+
+                /** \brief Compile an xml style file to a skin file.
+                 *
+                 * Resources are only declared in the skin file, nothing is loaded.
+                 * \param xmlFile The xml style file to compile.
+                 * \param skinFile The skin file to write.
+                 * \return true if the skin file has been written.
+                 * \return false otherwise.
+                 */
+                static bool             Compile(const std::string& xmlFile, const std::string& skinFile);
+
+
+                /** \brief Close the file. */
+                void                    Close();
+
+
+                /** \brief Get a declared resource.
+                 *
+                 * \param index The resource index.
+                 * \return The resource record.
+                 */
+                const Resource&         GetResource(Uint32 index) const;
+
+
+                /** \brief Get the number of declared resources.
+                 *
+                 * \return The number of resources.
+                 */
+                Uint32                  GetResourceCount() const;
+
+
+                /** \brief Get a style property.
+                 *
+                 * \param index The property index (see Style::FirstProperty).
+                 * \return The property record.
+                 */
+                const Property&         GetProperty(Uint32 index) const;
+
+
+                /** \brief Get a string from the string table.
+                 *
+                 * \param index The string index.
+                 * \return The null-terminated string.
+                 */
+                const char*             GetString(Uint32 index) const;
+
+
+                /** \brief Get the length of a string from the string table.
+                 *
+                 * \param index The string index.
+                 * \return The string length.
+                 */
+                Uint32                  GetStringLength(Uint32 index) const;
+
+
+                /** \brief Get a style.
+                 *
+                 * Styles are sorted by name.
+                 * \param index The style index.
+                 * \return The style record.
+                 */
+                const Style&            GetStyle(Uint32 index) const;
+
+
+                /** \brief Get the number of styles.
+                 *
+                 * \return The number of styles.
+                 */
+                Uint32                  GetStyleCount() const;
+
+
+                /** \brief Open a skin file.
+                 *
+                 * The file is memory-mapped when the system allows it, read otherwise.
+                 * \param filename The name of the skin file.
+                 * \return true if the file is a valid skin file.
+                 * \return false otherwise.
+                 */
+                bool                    Open(const std::string& filename);
+
+            private :
+
+                SkinFile(const SkinFile&);
+
+                SkinFile&               operator =(const SkinFile&);
+
+                bool                    Validate();
+
+                const char*             mData;
+
+                size_t                  mSize;
+
+                bool                    mMapped;
+
+                std::vector<char>       mBuffer;
+
+                const Uint32*           mStringEntries;
+
+                const Style*            mStyles;
+
+                const Property*         mProperties;
+
+                const Resource*         mResources;
+
+                const char*             mStringData;
+
+                Uint32                  mStringCount;
+
+                Uint32                  mStyleCount;
+
+                Uint32                  mPropertyCount;
+
+                Uint32                  mResourceCount;
+
+                Uint32                  mStringDataSize;
+
+        };
+    }
+}
+
+#endif // SKINFILE_HPP_INCLUDED
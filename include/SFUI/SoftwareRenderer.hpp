@@ -0,0 +1,208 @@
+#ifndef SOFTWARERENDERER_HPP_INCLUDED
+#define SOFTWARERENDERER_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file SoftwareRenderer.hpp
+ * \brief Render widgets into memory, without OpenGL.
+ * \author Robin Ruaux
+ */
+
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <SFUI/DistanceFieldText.hpp>
+#include <SFUI/Painter.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        class Widget;
+
+        /** \class SoftwareRenderer
+         *
+         * \brief Render widgets into memory, without OpenGL.
+         *
+         * The renderer owns a RGBA pixel buffer, widgets are drawn into it by a SoftwarePainter.
+         * The buffer has premultiplied alpha, CopyToImage and SaveToFile convert it back.
+         * It can be used on machines without GPU, for screenshots, golden-image tests or benchmarks.
+         *
+         * Sprites and glyphs are scaled with the nearest neighbour, shapes are axis-aligned
+         * and string styles (bold, italic, underlined) are ignored.
+         */
+        class SoftwareRenderer
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * \param width The buffer width.
+                 * \param height The buffer height.
+                 */
+                SoftwareRenderer(unsigned int width, unsigned int height);
+
+
+                /** \brief Fill the buffer with a color.
+                 *
+                 * \param color The clear color.
+                 */
+                void                Clear(const Color& color = Color(0, 0, 0));
+
+
+                /** \brief Copy the buffer to an image.
+                 *
+                 * \param image The destination image.
+                 * \return True if the image has been created.
+                 */
+                bool                CopyToImage(Image& image) const;
+
+
+                /** \brief Get the buffer height.
+                 *
+                 * \return The buffer height.
+                 */
+                unsigned int        GetHeight() const;
+
+
+                /** \brief Get the buffer pixels.
+                 *
+                 * \return The RGBA pixels with premultiplied alpha, row by row.
+                 */
+                const Uint8*        GetPixels() const;
+
+
+                /** \brief Get the buffer width.
+                 *
+                 * \return The buffer width.
+                 */
+                unsigned int        GetWidth() const;
+
+
+                /** \brief Render a widget and its children.
+                 *
+                 * The widget is drawn at its absolute position.
+                 * \param widget The widget to render.
+                 */
+                void                Render(const Widget& widget);
+
+
+                /** \brief Save the buffer to an image file.
+                 *
+                 * \param filename The image file name.
+                 * \return True if the file has been saved.
+                 */
+                bool                SaveToFile(const std::string& filename) const;
+
+
+            private :
+
+                friend class SoftwarePainter;
+
+                unsigned int        mHeight;
+
+                std::vector<Uint32> mPixels;
+
+                unsigned int        mWidth;
+
+        };
+
+
+        /** \class SoftwarePainter
+         *
+         * \brief Painter drawing into the buffer of a SoftwareRenderer.
+         */
+        class SoftwarePainter : public Painter
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * \param renderer The renderer owning the pixel buffer.
+                 */
+                SoftwarePainter(SoftwareRenderer& renderer);
+
+
+                /** \brief Blit the parts of a nine-slice image. */
+                virtual void        DrawNineSlice(const NineSlice& slice);
+
+
+                /** \brief Blit a sprite image. */
+                virtual void        DrawSprite(const Sprite& sprite);
+
+
+                /** \brief Blit the glyphs of a string, from the distance field of its font when it is scaled. */
+                virtual void        DrawString(const String& string);
+
+
+                /** \brief Fill a rectangle, the outline is drawn inside the rectangle. */
+                virtual void        FillRect(const FloatRect& rect, const Color& color, float outline = 0.f, const Color& outlineColor = Color(0, 0, 0, 0));
+
+
+                /** \brief Restore the previous clipping rectangle. */
+                virtual void        PopClip();
+
+
+                /** \brief Intersect the clipping rectangle with a rectangle. */
+                virtual void        PushClip(const FloatRect& rect);
+
+
+            private :
+
+                /** \brief Blit a part of an image, scaled to a destination rectangle.
+                 *
+                 * When coverage is true, only the image alpha is used, as the coverage of the color.
+                 */
+                void                BlitImage(const Image& image, IntRect source, const FloatRect& dest, const Color& color, bool coverage);
+
+                /** \brief Fill a rectangle in buffer coordinates, clipped. */
+                void                FillPixels(int left, int top, int right, int bottom, Uint32 color);
+
+                /** \brief Convert a rectangle relative to the origin to buffer coordinates. */
+                IntRect             ToPixels(const FloatRect& rect) const;
+
+                std::vector<IntRect>    mClips;
+
+                std::vector<Uint8>      mMask;
+
+                SoftwareRenderer&       mRenderer;
+
+                std::vector<Uint32>     mRow;
+
+                DistanceFieldText       mText;
+
+        };
+
+    }
+
+}
+
+#endif // SOFTWARERENDERER_HPP_INCLUDED
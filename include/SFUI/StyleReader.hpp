@@ -0,0 +1,98 @@
+#ifndef STYLEREADER_HPP_INCLUDED
+#define STYLEREADER_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file StyleReader.hpp
+ * \brief Streaming reader for xml style files.
+ * \author Robin Ruaux
+ */
+
+#include <string>
+
+#include <SFUI/ResourceManager.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** \class StyleReader
+         *
+         * \brief Streaming reader for xml style files.
+         *
+         * Style files are flat lists of \<style\> and \<resources\> elements. Instead of building
+         * the whole document in memory, the reader parses one top-level element at a time,
+         * hands its content to OnStyle() or OnResource() and throws it away.
+         *
+         * Subclasses decide where styles and resources go (ResourceManager tables, skin compiler...).
+         */
+        class StyleReader
+        {
+            public :
+
+                /** \brief Destructor
+                 *
+                 * Destructor of StyleReader class.
+                 */
+                virtual ~StyleReader() {}
+
+
+                /** \brief Read a style file.
+                 *
+                 * \param filename The name of the file to read.
+                 * \return true if the whole file has been read.
+                 * \return false otherwise (errors are reported on std::cerr).
+                 */
+                bool                Read(const std::string& filename);
+
+            protected :
+
+                /** \brief Called for each \<font\> and \<image\> element of a \<resources\> block.
+                 *
+                 * \param type The resource type ("font" or "image").
+                 * \param name The resource alias.
+                 * \param src The resource file.
+                 * \param size The font size (30 if not specified).
+                 */
+                virtual void        OnResource(const std::string& type, const std::string& name, const std::string& src, float size) = 0;
+
+
+                /** \brief Called for each \<style\> element.
+                 *
+                 * The properties can be swapped by the handler to avoid a copy.
+                 * \param name The style name.
+                 * \param properties The style properties ("name" excluded).
+                 */
+                virtual void        OnStyle(const std::string& name, StyleProperties& properties) = 0;
+
+        };
+    }
+}
+
+#endif // STYLEREADER_HPP_INCLUDED
@@ -0,0 +1,198 @@
+#ifndef TASKPOOL_HPP_INCLUDED
+#define TASKPOOL_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file TaskPool.hpp
+ * \brief Worker threads running background tasks for the GUI.
+ * \author Robin Ruaux
+ */
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include <SFML/System/Mutex.hpp>
+
+#include <SFUI/Semaphore.hpp>
+
+namespace sf
+{
+    class Thread;
+
+    namespace ui
+    {
+        /** \class Task
+         *
+         * \brief A background job submitted to a TaskPool.
+         *
+         * Run() is called by a worker thread : it must not touch widgets, resources or the rendering
+         * context. OnComplete() is called afterwards by the GUI thread, to give the results back to
+         * the widgets. The pool deletes the task after OnComplete().
+         */
+        class Task
+        {
+            public :
+
+                /** \brief Destructor
+                 *
+                 * Destructor of Task class.
+                 */
+                virtual ~Task()
+                {}
+
+
+                /** \brief Give the results back, on the GUI thread.
+                 *
+                 */
+                virtual void        OnComplete()
+                {}
+
+
+                /** \brief Do the job, on a worker thread.
+                 *
+                 */
+                virtual void        Run() = 0;
+
+        };
+
+
+        /** \class TaskPool
+         *
+         * \brief Worker threads running background tasks for the GUI.
+         *
+         * The workers share one queue and block on a semaphore while it is empty, they use no
+         * processor time while the GUI is idle. Tasks are run in submission order.
+         *
+         * Finished tasks wait for Dispatch(), which GuiRenderer::Display() calls at the start of each
+         * frame. Submit() and Dispatch() must be called from the GUI thread, ParallelFor() from any thread.
+         */
+        class TaskPool
+        {
+            public :
+
+                /** \brief Constructor
+                 *
+                 * Constructor of TaskPool class.
+                 * \param threadCount The number of worker threads (0 for one thread per processor, the GUI thread excepted).
+                 */
+                explicit TaskPool(unsigned int threadCount = 0);
+
+
+                /** \brief Destructor
+                 *
+                 * Destructor of TaskPool class. Waits for the running tasks, pending tasks are deleted without being run.
+                 */
+                ~TaskPool();
+
+
+                /** \brief Complete the finished tasks.
+                 *
+                 * Calls OnComplete() on each finished task, then deletes it.
+                 * \return The number of completed tasks.
+                 */
+                unsigned int        Dispatch();
+
+
+                /** \brief Get the number of tasks submitted and not completed yet.
+                 *
+                 * \return The number of pending tasks.
+                 */
+                unsigned int        GetPendingCount() const;
+
+
+                /** \brief Get the number of worker threads.
+                 *
+                 * \return The number of threads.
+                 */
+                unsigned int        GetThreadCount() const;
+
+
+                /** \brief Call a function for each index, on the workers and the calling thread.
+                 *
+                 * Indices are handed out by chunks, the call returns once the function was called for
+                 * all of them. Passes are run before the submitted tasks. The function is called on
+                 * worker threads : it has the same restrictions as Task::Run().
+                 * \param count The number of indices.
+                 * \param function The function to call, with the user data and the index.
+                 * \param userData The data given to the function.
+                 * \param chunkSize The number of indices handed out at once (more for short calls, to limit locking).
+                 */
+                void                ParallelFor(std::size_t count, void (*function)(void*, std::size_t), void* userData, std::size_t chunkSize = 64);
+
+
+                /** \brief Submit a task.
+                 *
+                 * The pool takes ownership of the task.
+                 * \param task The task to run.
+                 */
+                void                Submit(Task* task);
+
+
+            private :
+
+                struct Pass;
+
+                class PassTask;
+
+                TaskPool(const TaskPool&);
+
+                TaskPool&           operator=(const TaskPool&);
+
+                static void         ReleasePass(Pass* pass);
+
+                static void         RunPass(Pass* pass);
+
+                static void         RunWorker(void* userData);
+
+                std::vector<Task*>  mCompleted;
+
+                Mutex               mCompletedAccess;
+
+                std::deque<Task*>   mPassTasks;
+
+                unsigned int        mPendingCount;
+
+                Semaphore           mQueued;
+
+                bool                mStopping;
+
+                std::deque<Task*>   mTasks;
+
+                Mutex               mTasksAccess;
+
+                std::vector<Thread*> mThreads;
+
+        };
+
+    }
+
+}
+
+#endif // TASKPOOL_HPP_INCLUDED
@@ -1,6 +1,6 @@
-#ifndef WIDGET_HPP_INCLUDED
-#define WIDGET_HPP_INCLUDED
-
+#ifndef WIDGET_HPP_INCLUDED
+#define WIDGET_HPP_INCLUDED
+
 /*
     Copyright (c) 2009, Robin RUAUX
     All rights reserved.
@@ -34,12 +34,14 @@
  * \author Robin Ruaux
  */
 
+#include <cstddef>
 #include <vector>
 
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/Graphics/Rect.hpp>
 
+#include <SFUI/RectangleMesh.hpp>
 #include <SFUI/ResourceManager.hpp>
 
 namespace sf
@@ -50,6 +52,9 @@ namespace sf
         class GuiRenderer;
         class MouseListener;
         class KeyListener;
+        class Animator;
+        class Painter;
+        class TaskPool;
 
         /** \typedef std::vector<KeyListener*> KeyListeners
          *
@@ -67,7 +72,7 @@ namespace sf
 
         /** \typedef std::vector<Widget*> Widgets
          *
-         * A basic container of widgets.
+         * A basic container of widgets (children are stored in an intrusive list, see Widget::GetChildren()).
          */
         typedef std::vector<Widget*> Widgets;
 
@@ -120,6 +125,7 @@ namespace sf
                     COLOR,
                     ENABLE,
                     FOCUSABLE,
+                    OPACITY,
                     PARENT,
                     SIZE,
                     VISIBLE
@@ -231,11 +237,20 @@ namespace sf
 
                 /** \brief Get the widget children.
                  *
-                 * \return The widget children (as a std::vector container).
+                 * The container is rebuilt from the children list after each change, prefer
+                 * GetFirstChild() and GetNextSibling() to walk the children.
+                 * \return The widget children (as a std::vector container), from the lowest to the highest.
                  */
                 const Widgets&      GetChildren() const;
 
 
+                /** \brief Get the style loaded by the last LoadStyle() call.
+                 *
+                 * \return The current style name.
+                 */
+                const std::string&  GetCurrentStyle() const;
+
+
                 /** \brief Get the default style value.
                  *
                  * \return The default style value.
@@ -243,6 +258,13 @@ namespace sf
                 const std::string&  GetDefaultStyle() const;
 
 
+                /** \brief Get the first child of the widget.
+                 *
+                 * \return The child all below others (0 if not exist).
+                 */
+                Widget*             GetFirstChild() const;
+
+
                 /** \brief Get the widget height.
                  *
                  * \return The widget height.
@@ -250,6 +272,45 @@ namespace sf
                 float               GetHeight() const;
 
 
+                /** \brief Get the last child of the widget.
+                 *
+                 * \return The child all above others (0 if not exist).
+                 */
+                Widget*             GetLastChild() const;
+
+
+                /** \brief Get the size the widget needs in a layout.
+                 *
+                 * The size is computed by OnMeasure() and kept until InvalidateMeasure() is called, layouts read
+                 * it at each arrangement without measuring unchanged children again.
+                 * \return The measured size.
+                 */
+                const Vector2f&     GetMeasuredSize() const;
+
+
+                /** \brief Get the size asked for the widget.
+                 *
+                 * This is the last size given by SetSize(), SetWidth() or SetHeight() (or by the style) : a layout
+                 * stretching the widget changes its size, not its preferred size.
+                 * \return The preferred size.
+                 */
+                const Vector2f&     GetPreferredSize() const;
+
+
+                /** \brief Get the brother just above the widget.
+                 *
+                 * \return The next brother (0 if not exist).
+                 */
+                Widget*             GetNextSibling() const;
+
+
+                /** \brief Get the widget opacity.
+                 *
+                 * \return The opacity, from 0 (transparent) to 1 (opaque).
+                 */
+                float               GetOpacity() const;
+
+
                 /** \brief Get the widget parent.
                  *
                  * \return The widget parent (0 if not exist).
@@ -257,6 +318,13 @@ namespace sf
                 Widget*             GetParent() const;
 
 
+                /** \brief Get the brother just below the widget.
+                 *
+                 * \return The previous brother (0 if not exist).
+                 */
+                Widget*             GetPreviousSibling() const;
+
+
                 /** \brief Get the widget rectangle.
                  *
                  * \param absolute Use absolute or relative position.
@@ -272,6 +340,23 @@ namespace sf
                 const Vector2f&     GetSize() const;
 
 
+                /** \brief Get the animator of the GUI, to tween widget properties.
+                 *
+                 * The animator belongs to the GuiRenderer, animations are updated at the start of each frame.
+                 * \return The animator (0 if there is no GuiRenderer).
+                 */
+                static Animator*    GetAnimator();
+
+
+                /** \brief Get the task pool of the GUI, to run jobs in the background.
+                 *
+                 * The pool and its threads are created on the first call, and deleted with the GuiRenderer.
+                 * Finished tasks are completed at the start of each frame.
+                 * \return The task pool.
+                 */
+                static TaskPool*    GetTaskPool();
+
+
                 /** \brief Get the widget width.
                  *
                  * \return The widget width.
@@ -293,6 +378,33 @@ namespace sf
                  */
                 bool                HasFocus() const;
 
+                /** \brief Discard the measured size of the widget and of its parents.
+                 *
+                 * This is done when the widget size is set, and when children are added, removed, shown or hidden.
+                 * Widgets measuring their content call it when the content changes. The widgets are laid out
+                 * again at the next GuiRenderer::Display().
+                 */
+                void                InvalidateMeasure();
+
+
+                /** \brief Ask the layout pass to lay out the widget again.
+                 *
+                 * The measured size is kept. Layouts call it when they are resized, so that they are arranged
+                 * once at the next GuiRenderer::Display(), whatever the number of resizes.
+                 */
+                void                InvalidateLayout();
+
+
+                /** \brief Check if the widget is drawn above a brother.
+                 *
+                 * Brothers keep sortable z keys, updated by ChangeZIndex() and Add() without walking the
+                 * children : the comparison doesn't depend on the number of brothers.
+                 * \param brother Another child of the widget parent.
+                 * \return True if the widget is above the brother (false if they don't share the same parent).
+                 */
+                bool                IsAbove(const Widget* brother) const;
+
+
                 /** \brief Check if the widget is enabled.
                  *
                  * \return The widget enabled property.
@@ -329,6 +441,14 @@ namespace sf
                 virtual void        LoadStyle(const std::string& style = "");
 
 
+                /** \brief Paint the widget and its children with a painter.
+                 *
+                 * Hidden widgets are not painted. Clipped widgets (see UseScissor()) restrict the painter to their rectangle.
+                 * \param painter The painter, its origin being the absolute position of the widget parent.
+                 */
+                void                Paint(Painter& painter) const;
+
+
                 /** \brief Remove a child from the widget.
                  *
                  * \param widget To widget to be removed.
@@ -408,6 +528,35 @@ namespace sf
                 void                SetHeight(float height);
 
 
+                /** \brief Set the style loaded by the constructor of the next widget created with new.
+                 *
+                 * The widget loads this style instead of its default style, which is kept (see GetDefaultStyle()).
+                 * LayoutFile::Build() uses it to style each widget once. Only the GUI thread may use it.
+                 * \param style The style name (empty to load the default style again).
+                 */
+                static void         SetInitialStyle(const std::string& style);
+
+
+                /** \brief Set the position and size given by a layout.
+                 *
+                 * Unlike SetPosition() and SetSize(), the measured size is kept : a layout stretching a widget
+                 * doesn't make it measure bigger. This method send a Property::SIZE signal when the size changes.
+                 * \param rect The widget rectangle, relative to its parent.
+                 */
+                void                SetLayoutRect(const FloatRect& rect);
+
+
+                /** \brief Set the opacity of the widget and its children.
+                 *
+                 * The opacity multiplies the alpha of everything drawn by the widget and its children, and
+                 * is multiplied by the opacity of the parents : fading a whole window is one call.
+                 * A transparent widget is not drawn, like a hidden one.
+                 * This method send a Property::OPACITY signal.
+                 * \param opacity The opacity, from 0 (transparent) to 1 (opaque).
+                 */
+                void                SetOpacity(float opacity);
+
+
                 /** \brief Set the widget size.
                  *
                  * This method send a Property::SIZE signal.
@@ -453,15 +602,42 @@ namespace sf
                 void                UseScissor(bool useScissor);
 
 
+                /** \brief Allocate a widget from the WidgetPool.
+                 *
+                 * \param size The size of the widget.
+                 */
+                static void*        operator new(std::size_t size);
+
+
+                /** \brief Give a widget memory back to the WidgetPool.
+                 *
+                 * \param memory The widget memory.
+                 * \param size The size of the widget.
+                 */
+                static void         operator delete(void* memory, std::size_t size);
+
+
             protected:
 
+                /** \brief Get the style loaded by the constructor : the default style, unless SetInitialStyle() was called. */
+                const std::string&  GetInitialStyle() const;
+
                 /** \brief Called when a widget property-changed signal has been received. */
                 virtual void        OnChange(Widget::Property property);
 
-                /** \brief Called when the widget is drawed on screen. */
-                virtual void        OnPaint(RenderTarget& target, RenderQueue& queue) const;
+                /** \brief Called when a child is removed, given to another parent or destroyed. */
+                virtual void        OnChildRemoved(const Widget* child);
 
-                /** \brief Render the widget to the screen. */
+                /** \brief Called by the layout pass when the widget or one of its children changed measure. */
+                virtual void        OnLayout();
+
+                /** \brief Called when the measured size is needed again, returns the preferred size by default. */
+                virtual Vector2f    OnMeasure() const;
+
+                /** \brief Called when the widget is drawed, with coordinates relative to the widget. */
+                virtual void        OnPaint(Painter& painter) const;
+
+                /** \brief Render the widget and its children to the screen, through Paint(). */
                 virtual void        Render(RenderTarget& target, RenderQueue& queue) const;
 
             private:
@@ -469,11 +645,14 @@ namespace sf
                 /** \brief Distribute an event to listeners */
                 void                DistributeEvent(const Event& event);
 
-                /** \brief Check if the widget is a direct child. */
-                Widgets::iterator   Find(const Widget* widget);
+                /** \brief Insert a child in the children list, after another one (at the bottom if 0). */
+                void                Link(Widget* widget, Widget* previous);
+
+                /** \brief Take a child out of the children list. */
+                void                Unlink(Widget* widget);
 
-                /** \brief Call children render method. */
-                void                RenderChildren(RenderTarget& target, RenderQueue& queue) const;
+                /** \brief Lay out the widgets changed since the last pass. */
+                void                UpdateLayout();
 
                 Align::Alignment    mAlign;
 
@@ -481,35 +660,75 @@ namespace sf
 
                 Color               mBorderColor;
 
-                Widgets             mChildren;
+                mutable Widgets     mChildren;
+
+                mutable bool        mChildrenChanged;
 
                 std::string         mDefaultStyle;
 
+                std::string         mStyle;
+
                 bool                mEnabled;
 
+                Widget*             mFirstChild;
+
                 bool                mFocusable;
 
                 static Widget*      mFocusedWidget;
 
                 static Widget*      mHoveredWidget;
 
+                static const void*  mInitialMemory;
+
+                static bool         mInitialPending;
+
+                static std::string  mInitialStyle;
+
+                static Widget*      mLastHovered;
+
+                static TaskPool*    mTaskPool;
+
+                static Animator*    mAnimator;
+
                 KeyListeners        mKeyListeners;
 
+                Widget*             mLastChild;
+
+                bool                mChildLayoutValid;
+
+                bool                mLayoutValid;
+
+                mutable Vector2f    mMeasuredSize;
+
+                mutable bool        mMeasureValid;
+
+                mutable RectangleMesh mMesh;
+
                 MouseListeners      mMouseListeners;
 
+                Widget*             mNextSibling;
+
+                float               mOpacity;
+
                 Widget*             mParent;
 
+                Vector2f            mPreferredSize;
+
+                Widget*             mPrevSibling;
+
                 Vector2f            mSize;
 
                 bool                mUseScissor;
 
                 bool                mVisible;
 
+                Uint32              mZKey;
+
         };
 
     }
 
 
-}
-
-#endif // WIDGET_HPP_INCLUDED
+}
+
+#endif // WIDGET_HPP_INCLUDED
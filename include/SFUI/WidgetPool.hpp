@@ -0,0 +1,118 @@
+#ifndef WIDGETPOOL_HPP_INCLUDED
+#define WIDGETPOOL_HPP_INCLUDED
+
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/** \file WidgetPool.hpp
+ * \brief Memory pool used to allocate widgets.
+ * \author Robin Ruaux
+ */
+
+#include <cstddef>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** \class WidgetPool
+         *
+         * \brief Memory pool used to allocate widgets.
+         *
+         * Widgets created with new are allocated by this pool (see Widget::operator new()).
+         * Memory is grouped by size classes of 16 bytes and reserved by blocks, freed widgets are kept
+         * in a free list of their size class and reused by the next widget of the same size.
+         * Size classes go up to 4 KB, which covers every widget of the library.
+         *
+         * Reserved blocks are only given back to the system at the end of the program : the pool is
+         * never destroyed, so widgets deleted by static destructors are still released safely.
+         *
+         * The pool is not thread-safe : widgets must only be created and deleted in the GUI thread
+         * (not in Task::Run(), see TaskPool).
+         */
+        class WidgetPool
+        {
+            public :
+
+                /** \brief Allocate memory for a widget.
+                 *
+                 * Sizes bigger than the largest size class are allocated with the global operator new.
+                 * \param size The size of the widget.
+                 * \return The allocated memory.
+                 */
+                static void*        Allocate(std::size_t size);
+
+
+                /** \brief Get the number of widgets allocated by the pool.
+                 *
+                 * \return The number of allocated widgets.
+                 */
+                static unsigned int GetAllocatedCount();
+
+
+                /** \brief Get the memory reserved by the pool.
+                 *
+                 * \return The reserved memory, in bytes.
+                 */
+                static std::size_t  GetReservedSize();
+
+
+                /** \brief Get the size of the slots used for a widget size.
+                 *
+                 * Widgets of different types share a size class when their sizes round to the same slot size.
+                 * \param size The size of the widget.
+                 * \return The slot size (the size itself when it is too big to be pooled).
+                 */
+                static std::size_t  GetSlotSize(std::size_t size);
+
+
+                /** \brief Give the memory of a widget back to the pool.
+                 *
+                 * \param memory The memory returned by Allocate().
+                 * \param size The size given to Allocate().
+                 */
+                static void         Release(void* memory, std::size_t size);
+
+
+                /** \brief Make sure that widgets of the same size class can be allocated without reserving memory.
+                 *
+                 * The free slots of the size class count : only the missing slots are reserved, in one block.
+                 * When no slot is free, the next widgets of that size class are allocated one after the other
+                 * in the block, this is used to build many widgets at once (see LayoutFile::Build()).
+                 * \param size The size of the widgets.
+                 * \param count The number of widgets.
+                 */
+                static void         Reserve(std::size_t size, unsigned int count);
+
+        };
+
+    }
+
+}
+
+#endif // WIDGETPOOL_HPP_INCLUDED
@@ -0,0 +1,312 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <SFUI/Animator.hpp>
+#include <SFUI/Widget.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** Easing curves as polynomials a.t + b.t^2 + c.t^3, so all animations share one loop */
+        static const float  _easingCurves[4][3] =
+        {
+            {1.f, 0.f, 0.f},    // LINEAR
+            {0.f, 1.f, 0.f},    // EASE_IN
+            {2.f, -1.f, 0.f},   // EASE_OUT
+            {0.f, 3.f, -2.f}    // EASE_IN_OUT
+        };
+
+        static Uint8    _ToComponent(float value)
+        {
+            return static_cast<Uint8>(std::min(255.f, std::max(0.f, std::floor(value + 0.5f))));
+        }
+
+        Animator::Animator()
+            :   mUpdating(false)
+        {
+
+        }
+
+        void    Animator::Add(Widget& widget, Property property, const float* from, const float* to, float duration, Easing easing)
+        {
+            const Key key(&widget, static_cast<Uint8>(property));
+            Indices::iterator it = mIndices.find(key);
+            unsigned int index = static_cast<unsigned int>(mWidgets.size());
+
+            // The running animation restarts in place, except during an update : it is replaced by a new one
+            if (it != mIndices.end() && !mUpdating)
+            {
+                index = it->second;
+            }
+            else
+            {
+                if (it != mIndices.end())
+                    Kill(it->second);
+
+                mIndices[key] = index;
+                mWidgets.push_back(&widget);
+                mProperties.push_back(static_cast<Uint8>(property));
+                mElapsed.push_back(0.f);
+                mDurations.push_back(0.f);
+                mLinear.push_back(0.f);
+                mQuadratic.push_back(0.f);
+                mCubic.push_back(0.f);
+
+                for (unsigned int c = 0; c < 4; ++c)
+                {
+                    mFrom[c].push_back(0.f);
+                    mTo[c].push_back(0.f);
+                    mValues[c].push_back(0.f);
+                }
+            }
+
+            mElapsed[index] = 0.f;
+            mDurations[index] = std::max(duration, 0.f);
+            mLinear[index] = _easingCurves[easing][0];
+            mQuadratic[index] = _easingCurves[easing][1];
+            mCubic[index] = _easingCurves[easing][2];
+
+            for (unsigned int c = 0; c < 4; ++c)
+            {
+                mFrom[c][index] = from[c];
+                mTo[c][index] = to[c];
+            }
+        }
+
+        void    Animator::AnimateAlpha(Widget& widget, Uint8 alpha, float duration, Easing easing)
+        {
+            const float from[4] = {static_cast<float>(widget.GetColor().a), 0.f, 0.f, 0.f};
+            const float to[4] = {static_cast<float>(alpha), 0.f, 0.f, 0.f};
+
+            Add(widget, ALPHA, from, to, duration, easing);
+        }
+
+        void    Animator::AnimateColor(Widget& widget, const Color& color, float duration, Easing easing)
+        {
+            const Color& current = widget.GetColor();
+            const float from[4] = {static_cast<float>(current.r), static_cast<float>(current.g), static_cast<float>(current.b), static_cast<float>(current.a)};
+            const float to[4] = {static_cast<float>(color.r), static_cast<float>(color.g), static_cast<float>(color.b), static_cast<float>(color.a)};
+
+            Add(widget, COLOR, from, to, duration, easing);
+        }
+
+        void    Animator::AnimateOpacity(Widget& widget, float opacity, float duration, Easing easing)
+        {
+            const float from[4] = {widget.GetOpacity(), 0.f, 0.f, 0.f};
+            const float to[4] = {opacity, 0.f, 0.f, 0.f};
+
+            Add(widget, OPACITY, from, to, duration, easing);
+        }
+
+        void    Animator::AnimatePosition(Widget& widget, const Vector2f& position, float duration, Easing easing)
+        {
+            const Vector2f& current = widget.GetPosition();
+            const float from[4] = {current.x, current.y, 0.f, 0.f};
+            const float to[4] = {position.x, position.y, 0.f, 0.f};
+
+            Add(widget, POSITION, from, to, duration, easing);
+        }
+
+        void    Animator::AnimateSize(Widget& widget, const Vector2f& size, float duration, Easing easing)
+        {
+            const Vector2f& current = widget.GetSize();
+            const float from[4] = {current.x, current.y, 0.f, 0.f};
+            const float to[4] = {size.x, size.y, 0.f, 0.f};
+
+            Add(widget, SIZE, from, to, duration, easing);
+        }
+
+        unsigned int    Animator::GetCount() const
+        {
+            return static_cast<unsigned int>(mIndices.size());
+        }
+
+        bool    Animator::IsAnimated(const Widget& widget) const
+        {
+            Indices::const_iterator it = mIndices.lower_bound(Key(&widget, 0));
+
+            return (it != mIndices.end() && it->first.first == &widget);
+        }
+
+        void    Animator::Kill(unsigned int index)
+        {
+            if (!mUpdating)
+            {
+                Remove(index);
+                return;
+            }
+
+            if (mWidgets[index])
+            {
+                mIndices.erase(Key(mWidgets[index], mProperties[index]));
+                mWidgets[index] = 0;
+            }
+        }
+
+        void    Animator::Remove(unsigned int index)
+        {
+            const unsigned int last = static_cast<unsigned int>(mWidgets.size()) - 1;
+
+            // Killed animations are not indexed anymore
+            if (mWidgets[index])
+                mIndices.erase(Key(mWidgets[index], mProperties[index]));
+            if (mWidgets[last] && last != index)
+                mIndices[Key(mWidgets[last], mProperties[last])] = index;
+
+            mWidgets[index] = mWidgets[last];
+            mProperties[index] = mProperties[last];
+            mElapsed[index] = mElapsed[last];
+            mDurations[index] = mDurations[last];
+            mLinear[index] = mLinear[last];
+            mQuadratic[index] = mQuadratic[last];
+            mCubic[index] = mCubic[last];
+
+            mWidgets.pop_back();
+            mProperties.pop_back();
+            mElapsed.pop_back();
+            mDurations.pop_back();
+            mLinear.pop_back();
+            mQuadratic.pop_back();
+            mCubic.pop_back();
+
+            for (unsigned int c = 0; c < 4; ++c)
+            {
+                mFrom[c][index] = mFrom[c][last];
+                mTo[c][index] = mTo[c][last];
+                mValues[c][index] = mValues[c][last];
+
+                mFrom[c].pop_back();
+                mTo[c].pop_back();
+                mValues[c].pop_back();
+            }
+        }
+
+        void    Animator::Stop(const Widget& widget)
+        {
+            std::vector<unsigned int> indices;
+
+            for (Indices::const_iterator it = mIndices.lower_bound(Key(&widget, 0)); it != mIndices.end() && it->first.first == &widget; ++it)
+                indices.push_back(it->second);
+
+            // The last indices first : the animations moved by Remove() are not stopped ones
+            std::sort(indices.begin(), indices.end());
+
+            for (unsigned int i = static_cast<unsigned int>(indices.size()); i > 0; --i)
+                Kill(indices[i - 1]);
+        }
+
+        void    Animator::Update(float elapsed)
+        {
+            const unsigned int count = static_cast<unsigned int>(mWidgets.size());
+
+            if (count == 0)
+                return;
+
+            mProgress.resize(count);
+
+            // Eased progress of each animation
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                mElapsed[i] += elapsed;
+
+                const float t = (mDurations[i] > 0.f) ? std::min(mElapsed[i] / mDurations[i], 1.f) : 1.f;
+
+                mProgress[i] = t * (mLinear[i] + t * (mQuadratic[i] + t * mCubic[i]));
+            }
+
+            // Then the values, component by component
+            const float* progress = &mProgress[0];
+
+            for (unsigned int c = 0; c < 4; ++c)
+            {
+                const float* from = &mFrom[c][0];
+                const float* to = &mTo[c][0];
+                float* values = &mValues[c][0];
+
+                for (unsigned int i = 0; i < count; ++i)
+                    values[i] = from[i] + (to[i] - from[i]) * progress[i];
+            }
+
+            // Results are applied once per animation, setters may start, stop or delete meanwhile
+            mUpdating = true;
+
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                if (!mWidgets[i])
+                    continue;
+
+                Widget& widget = *mWidgets[i];
+
+                switch (mProperties[i])
+                {
+                    case ALPHA :
+                    {
+                        Color color = widget.GetColor();
+                        color.a = _ToComponent(mValues[0][i]);
+                        widget.SetColor(color);
+                        break;
+                    }
+
+                    case COLOR :
+                        widget.SetColor(Color(_ToComponent(mValues[0][i]), _ToComponent(mValues[1][i]),
+                                              _ToComponent(mValues[2][i]), _ToComponent(mValues[3][i])));
+                        break;
+
+                    case OPACITY :
+                        widget.SetOpacity(mValues[0][i]);
+                        break;
+
+                    case POSITION :
+                        widget.SetPosition(mValues[0][i], mValues[1][i]);
+                        break;
+
+                    case SIZE :
+                        widget.SetSize(mValues[0][i], mValues[1][i]);
+                        break;
+                }
+            }
+
+            mUpdating = false;
+
+            // Killed and finished animations are removed, animations added by the setters are kept
+            for (unsigned int i = static_cast<unsigned int>(mWidgets.size()); i > 0; --i)
+            {
+                const unsigned int index = i - 1;
+
+                if (!mWidgets[index] || (index < count && mElapsed[index] >= mDurations[index]))
+                    Remove(index);
+            }
+        }
+
+    }
+
+}
@@ -42,7 +42,7 @@ namespace sf
                 mCheckIcon()
         {
             SetDefaultStyle("BI_CheckBox");
-            LoadStyle(GetDefaultStyle());
+            LoadStyle(GetInitialStyle());
 
             Add(&mDecorator);
             Add(&mCaption);
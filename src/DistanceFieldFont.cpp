@@ -0,0 +1,344 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <SFML/Graphics/Font.hpp>
+
+#include <SFUI/DistanceFieldFont.hpp>
+#include <SFUI/GlyphAtlas.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** Character size of the font rendering used to compute distances */
+        static const unsigned int   _baseSize = 64;
+
+        /** Distance range around the edges, in pixels of the base size */
+        static const unsigned int   _spread = 8;
+
+        /** Width of the distance field image */
+        static const unsigned int   _atlasWidth = 1024;
+
+        static const double         _infinity = 1e20;
+
+        static int  _Round(float value)
+        {
+            return static_cast<int>(std::floor(value + 0.5f));
+        }
+
+        /** Shelf packing of glyph boxes, with one pixel between boxes */
+        class _Packer
+        {
+            public :
+
+                _Packer() : mX(1), mY(1), mRowHeight(0) {}
+
+                IntRect         Add(int width, int height)
+                {
+                    if (mX + width + 1 > static_cast<int>(_atlasWidth))
+                    {
+                        mX = 1;
+                        mY += mRowHeight + 1;
+                        mRowHeight = 0;
+                    }
+
+                    IntRect rect(mX, mY, mX + width, mY + height);
+
+                    mX += width + 1;
+                    mRowHeight = std::max(mRowHeight, height);
+                    return rect;
+                }
+
+                unsigned int    GetHeight() const
+                {
+                    return mY + mRowHeight + 1;
+                }
+
+            private :
+
+                int     mX;
+                int     mY;
+                int     mRowHeight;
+        };
+
+        /** Squared euclidean distance transform of a 1D sampled function (Felzenszwalb and Huttenlocher) */
+        static void _Transform(double* values, unsigned int count, unsigned int stride, std::vector<double>& f, std::vector<int>& v, std::vector<double>& z)
+        {
+            for (unsigned int q = 0; q < count; ++q)
+                f[q] = values[q * stride];
+
+            int k = 0;
+            v[0] = 0;
+            z[0] = -_infinity;
+            z[1] = _infinity;
+
+            for (int q = 1; q < static_cast<int>(count); ++q)
+            {
+                double s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+
+                while (s <= z[k])
+                {
+                    --k;
+                    s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+                }
+
+                ++k;
+                v[k] = q;
+                z[k] = s;
+                z[k + 1] = _infinity;
+            }
+
+            k = 0;
+
+            for (int q = 0; q < static_cast<int>(count); ++q)
+            {
+                while (z[k + 1] < q)
+                    ++k;
+
+                values[q * stride] = (q - v[k]) * (q - v[k]) + f[v[k]];
+            }
+        }
+
+        /** Squared distances to the nearest zero of a grid, columns then rows */
+        static void _Transform(std::vector<double>& grid, unsigned int width, unsigned int height)
+        {
+            const unsigned int size = std::max(width, height);
+            std::vector<double> f(size), z(size + 1);
+            std::vector<int> v(size);
+
+            for (unsigned int x = 0; x < width; ++x)
+                _Transform(&grid[x], height, width, f, v, z);
+
+            for (unsigned int y = 0; y < height; ++y)
+                _Transform(&grid[y * width], width, 1, f, v, z);
+        }
+
+        DistanceFieldFont::DistanceFieldFont(GlyphAtlas& atlas)
+            :   mAtlas(atlas),
+                mHeight(0),
+                mWidth(0)
+        {
+
+        }
+
+        bool    DistanceFieldFont::LoadFromFile(const std::string& filename)
+        {
+            Font font;
+
+            if (!font.LoadFromFile(filename, _baseSize))
+                return false;
+
+            const Image& image = font.GetImage();
+            const Uint8* pixels = image.GetPixelsPtr();
+            const int imageWidth = static_cast<int>(image.GetWidth());
+            const float width = static_cast<float>(image.GetWidth());
+            const float height = static_cast<float>(image.GetHeight());
+            const int spread = static_cast<int>(_spread);
+
+            if (!pixels)
+                return false;
+
+            // Distance fields of each glyph, packed before the atlas size is known
+            std::vector< std::vector<Uint8> > fields;
+            std::vector<Uint32> codePoints;
+            _Packer packer;
+
+            mGlyphs.clear();
+
+            // Printable characters of the default charset (latin-1)
+            for (Uint32 c = 0x20; c <= 0xFF; ++c)
+            {
+                if (c >= 0x7F && c < 0xA0)
+                    continue;
+
+                const sf::Glyph& glyph = font.GetGlyph(c);
+                const IntRect source(_Round(glyph.TexCoords.Left * width), _Round(glyph.TexCoords.Top * height),
+                                     _Round(glyph.TexCoords.Right * width), _Round(glyph.TexCoords.Bottom * height));
+
+                Glyph& entry = mGlyphs[c];
+                entry.Advance = glyph.Advance;
+
+                if (source.Right <= source.Left || source.Bottom <= source.Top)
+                    continue;
+
+                // The glyph is padded by the spread, so that distances fade out around it
+                const int fieldWidth = source.Right - source.Left + 2 * spread;
+                const int fieldHeight = source.Bottom - source.Top + 2 * spread;
+                std::vector<double> inside(fieldWidth * fieldHeight), outside(fieldWidth * fieldHeight);
+
+                for (int y = 0; y < fieldHeight; ++y)
+                {
+                    for (int x = 0; x < fieldWidth; ++x)
+                    {
+                        const int sx = source.Left + x - spread;
+                        const int sy = source.Top + y - spread;
+                        const bool covered = (sx >= source.Left && sx < source.Right && sy >= source.Top && sy < source.Bottom
+                                              && pixels[4 * (sy * imageWidth + sx) + 3] >= 128);
+
+                        inside[y * fieldWidth + x] = covered ? 0.0 : _infinity;
+                        outside[y * fieldWidth + x] = covered ? _infinity : 0.0;
+                    }
+                }
+
+                _Transform(inside, fieldWidth, fieldHeight);
+                _Transform(outside, fieldWidth, fieldHeight);
+
+                fields.push_back(std::vector<Uint8>(fieldWidth * fieldHeight));
+                codePoints.push_back(c);
+
+                for (int i = 0; i < fieldWidth * fieldHeight; ++i)
+                {
+                    // Edges are half a pixel away from the centers of the pixels around them
+                    const double distance = (inside[i] == 0.0) ? std::sqrt(outside[i]) - 0.5 : 0.5 - std::sqrt(inside[i]);
+                    const double value = 128.0 + distance * 127.0 / _spread;
+
+                    fields.back()[i] = static_cast<Uint8>(std::min(255.0, std::max(0.0, std::floor(value + 0.5))));
+                }
+
+                entry.Rectangle = IntRect(glyph.Rectangle.Left - spread, glyph.Rectangle.Top - spread,
+                                          glyph.Rectangle.Right + spread, glyph.Rectangle.Bottom + spread);
+                entry.Source = packer.Add(fieldWidth, fieldHeight);
+            }
+
+            mWidth = _atlasWidth;
+            mHeight = packer.GetHeight();
+            mDistances.assign(mWidth * mHeight, 0);
+
+            for (unsigned int i = 0; i < codePoints.size(); ++i)
+            {
+                const IntRect& rect = mGlyphs[codePoints[i]].Source;
+                const int fieldWidth = rect.Right - rect.Left;
+
+                for (int y = rect.Top; y < rect.Bottom; ++y)
+                    std::copy(&fields[i][(y - rect.Top) * fieldWidth], &fields[i][(y - rect.Top) * fieldWidth] + fieldWidth, &mDistances[y * mWidth + rect.Left]);
+            }
+
+            // Glyphs of the previous font are obsolete (they stay in the atlas, unused)
+            mSizedGlyphs.clear();
+
+            return true;
+        }
+
+        unsigned int    DistanceFieldFont::GetBaseSize() const
+        {
+            return _baseSize;
+        }
+
+        float   DistanceFieldFont::Sample(float x, float y) const
+        {
+            if (mDistances.empty())
+                return -static_cast<float>(_spread);
+
+            // Texel centers are at half pixels
+            x -= 0.5f;
+            y -= 0.5f;
+
+            const int left = static_cast<int>(std::floor(x));
+            const int top = static_cast<int>(std::floor(y));
+            const float tx = x - left;
+            const float ty = y - top;
+
+            const int maxX = static_cast<int>(mWidth) - 1;
+            const int maxY = static_cast<int>(mHeight) - 1;
+            const int x0 = std::min(std::max(left, 0), maxX);
+            const int x1 = std::min(std::max(left + 1, 0), maxX);
+            const int y0 = std::min(std::max(top, 0), maxY);
+            const int y1 = std::min(std::max(top + 1, 0), maxY);
+
+            const float topValue = mDistances[y0 * mWidth + x0] * (1.f - tx) + mDistances[y0 * mWidth + x1] * tx;
+            const float bottomValue = mDistances[y1 * mWidth + x0] * (1.f - tx) + mDistances[y1 * mWidth + x1] * tx;
+            const float value = topValue * (1.f - ty) + bottomValue * ty;
+
+            return (value - 128.f) * _spread / 127.f;
+        }
+
+        const DistanceFieldFont::Glyph&     DistanceFieldFont::GetGlyph(Uint32 codePoint, unsigned int characterSize) const
+        {
+            static const Glyph empty;
+            const std::pair<unsigned int, Uint32> key(characterSize, codePoint);
+            SizedGlyphs::const_iterator found = mSizedGlyphs.find(key);
+
+            if (found != mSizedGlyphs.end())
+                return found->second;
+
+            Glyphs::const_iterator it = mGlyphs.find(codePoint);
+
+            if (it == mGlyphs.end())
+                return empty;
+
+            const Glyph& glyph = it->second;
+            const float scale = static_cast<float>(characterSize) / _baseSize;
+            Glyph& scaled = mSizedGlyphs[key];
+
+            scaled.Advance = _Round(glyph.Advance * scale);
+
+            if (glyph.Source.Right <= glyph.Source.Left)
+                return scaled;
+
+            const IntRect rect(static_cast<int>(std::floor(glyph.Rectangle.Left * scale)), static_cast<int>(std::floor(glyph.Rectangle.Top * scale)),
+                               static_cast<int>(std::ceil(glyph.Rectangle.Right * scale)), static_cast<int>(std::ceil(glyph.Rectangle.Bottom * scale)));
+            const int width = rect.Right - rect.Left;
+            const int height = rect.Bottom - rect.Top;
+            std::vector<Uint8> coverage(width * height);
+
+            for (int y = 0; y < height; ++y)
+            {
+                // Pixel centers, back in the distance field
+                const float fieldY = glyph.Source.Top + ((y + rect.Top) + 0.5f) / scale - glyph.Rectangle.Top;
+
+                for (int x = 0; x < width; ++x)
+                {
+                    const float fieldX = glyph.Source.Left + ((x + rect.Left) + 0.5f) / scale - glyph.Rectangle.Left;
+
+                    // The distance is converted to pixels of this size, the edge is blended over one pixel
+                    const float value = 0.5f + Sample(fieldX, fieldY) * scale;
+
+                    coverage[y * width + x] = static_cast<Uint8>(std::min(255, std::max(0, _Round(value * 255.f))));
+                }
+            }
+
+            // A glyph which does not fit in the atlas is not drawn
+            scaled.Source = mAtlas.Add(width, height, &coverage[0]);
+
+            if (scaled.Source.Right > scaled.Source.Left)
+                scaled.Rectangle = rect;
+
+            return scaled;
+        }
+
+        const Image&    DistanceFieldFont::GetImage(RenderTarget* target) const
+        {
+            return mAtlas.GetImage(target);
+        }
+
+    }
+
+}
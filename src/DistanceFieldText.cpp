@@ -0,0 +1,146 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderQueue.hpp>
+#include <SFML/Graphics/String.hpp>
+
+#include <SFUI/DistanceFieldFont.hpp>
+#include <SFUI/DistanceFieldText.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        DistanceFieldText::DistanceFieldText()
+            :   Drawable(),
+                mFont(0)
+        {
+
+        }
+
+        const Image*    DistanceFieldText::GetImage() const
+        {
+            return (mFont) ? &mFont->GetImage() : 0;
+        }
+
+        const std::vector<DistanceFieldText::Quad>&     DistanceFieldText::GetQuads() const
+        {
+            return mQuads;
+        }
+
+        void    DistanceFieldText::SetString(const DistanceFieldFont& font, const String& string)
+        {
+            // Glyphs are rasterized at the nearest integer size, then slightly scaled
+            const unsigned int characterSize = static_cast<unsigned int>(std::max(1.f, std::floor(string.GetSize() + 0.5f)));
+            const float factor = string.GetSize() / characterSize;
+            const Unicode::UTF32String& text = string.GetText();
+
+            SetPosition(string.GetPosition());
+            SetColor(string.GetColor());
+
+            mQuads.clear();
+
+            // Same layout as sf::String : the first baseline is one character size below the top
+            float x = 0.f;
+            float y = static_cast<float>(characterSize);
+
+            for (Unicode::UTF32String::const_iterator it = text.begin(); it != text.end(); ++it)
+            {
+                const Uint32 c = *it;
+
+                if (c == L'\n')
+                {
+                    x = 0.f;
+                    y += characterSize;
+                    continue;
+                }
+                else if (c == L' ')
+                {
+                    x += font.GetGlyph(L' ', characterSize).Advance;
+                    continue;
+                }
+                else if (c == L'\t')
+                {
+                    x += font.GetGlyph(L' ', characterSize).Advance * 4;
+                    continue;
+                }
+
+                const DistanceFieldFont::Glyph& glyph = font.GetGlyph(c, characterSize);
+                const IntRect& rect = glyph.Rectangle;
+
+                if (rect.Right > rect.Left && rect.Bottom > rect.Top)
+                {
+                    Quad quad;
+
+                    quad.Dest = FloatRect((x + rect.Left) * factor, (y + rect.Top) * factor, (x + rect.Right) * factor, (y + rect.Bottom) * factor);
+                    quad.Source = glyph.Source;
+                    mQuads.push_back(quad);
+                }
+
+                x += glyph.Advance;
+            }
+
+            // The atlas is only uploaded when the text is drawn, maybe by the render thread
+            mFont = &font;
+        }
+
+        void    DistanceFieldText::Render(RenderTarget& target, RenderQueue& queue) const
+        {
+            if (!mFont || mQuads.empty())
+                return;
+
+            // Requested after the glyphs were added, so that they are uploaded. The texts queued before are
+            // drawn first if the atlas grows
+            const Image* image = &mFont->GetImage(&target);
+
+            queue.SetTexture(image);
+            queue.BeginBatch();
+
+            for (unsigned int i = 0; i < mQuads.size(); ++i)
+            {
+                const FloatRect& dest = mQuads[i].Dest;
+                const FloatRect coords = image->GetTexCoords(mQuads[i].Source);
+                const unsigned int first = i * 4;
+
+                queue.AddVertex(dest.Left, dest.Top, coords.Left, coords.Top);
+                queue.AddVertex(dest.Right, dest.Top, coords.Right, coords.Top);
+                queue.AddVertex(dest.Right, dest.Bottom, coords.Right, coords.Bottom);
+                queue.AddVertex(dest.Left, dest.Bottom, coords.Left, coords.Bottom);
+
+                queue.AddTriangle(first, first + 1, first + 2);
+                queue.AddTriangle(first, first + 2, first + 3);
+            }
+        }
+
+    }
+
+}
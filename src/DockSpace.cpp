@@ -0,0 +1,368 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <SFUI/DockSpace.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** \brief A docked window, with the movable properties it had before being docked. */
+        struct _DockedTab
+        {
+            Window*     Tab;
+
+            bool        MovableX;
+
+            bool        MovableY;
+        };
+
+        /** \brief A leaf holding tabs, or a split of two nodes. */
+        struct DockSpace::Node
+        {
+            Node(Node* parent)
+                :   ActiveTab(0),
+                    First(0),
+                    Parent(parent),
+                    Ratio(0.5f),
+                    Rect(0.f, 0.f, 0.f, 0.f),
+                    Second(0),
+                    Tabs(),
+                    Vertical(false)
+            {
+
+            }
+
+            Window*                 ActiveTab;
+
+            // Left or top node of a split (0 for a leaf)
+            Node*                   First;
+
+            Node*                   Parent;
+
+            // Share of the split given to the first node
+            float                   Ratio;
+
+            FloatRect               Rect;
+
+            Node*                   Second;
+
+            std::vector<_DockedTab> Tabs;
+
+            bool                    Vertical;
+        };
+
+        DockSpace::DockSpace()
+            :   Widget(),
+                mLeaves(),
+                mRoot(new Node(0)),
+                mSpacing(4.f)
+        {
+            SetDefaultStyle("BI_DockSpace");
+            LoadStyle(GetInitialStyle());
+        }
+
+        DockSpace::~DockSpace()
+        {
+            DeleteNode(mRoot);
+        }
+
+        void    DockSpace::DeleteNode(Node* node)
+        {
+            if (!node)
+                return;
+
+            DeleteNode(node->First);
+            DeleteNode(node->Second);
+            delete node;
+        }
+
+        void    DockSpace::MoveNode(Node* from, Node* to)
+        {
+            to->ActiveTab = from->ActiveTab;
+            to->First = from->First;
+            to->Ratio = from->Ratio;
+            to->Second = from->Second;
+            to->Tabs.swap(from->Tabs);
+            to->Vertical = from->Vertical;
+
+            if (to->First)
+                to->First->Parent = to->Second->Parent = to;
+
+            for (std::vector<_DockedTab>::const_iterator it = to->Tabs.begin(); it != to->Tabs.end(); ++it)
+                mLeaves[it->Tab] = to;
+
+            from->ActiveTab = 0;
+            from->First = from->Second = 0;
+        }
+
+        bool    DockSpace::Dock(Window* window, Window* target, DockSide side, float ratio)
+        {
+            if (!window || IsDocked(window))
+                return false;
+
+            Node* node = mRoot;
+
+            if (target)
+            {
+                Leaves::const_iterator it = mLeaves.find(target);
+
+                if (it == mLeaves.end())
+                {
+                    std::cerr << "Can't dock a window beside an undocked target" << std::endl;
+                    return false;
+                }
+                node = it->second;
+            }
+            else if (!mRoot->First && mRoot->Tabs.empty())
+            {
+                // The first window takes the whole space, a split would leave an empty area beside it
+                side = TAB;
+            }
+            else if (side == TAB)
+            {
+                side = RIGHT;
+            }
+
+            Add(window);
+            window->SetAlignment(Align::NONE);
+
+            const _DockedTab tab = {window, window->IsMovableX(), window->IsMovableY()};
+            window->SetMovable(false);
+
+            // Only the target area is placed again
+            Node* changed = node;
+
+            if (side != TAB)
+            {
+                // The node becomes a split between its former content and the new window
+                Node* former = new Node(node);
+                Node* leaf = new Node(node);
+                const bool first = (side == LEFT || side == TOP);
+
+                MoveNode(node, former);
+
+                node->First = first ? leaf : former;
+                node->Second = first ? former : leaf;
+                node->Ratio = first ? ratio : 1.f - ratio;
+                node->Vertical = (side == TOP || side == BOTTOM);
+
+                node = leaf;
+            }
+
+            node->Tabs.push_back(tab);
+            mLeaves[window] = node;
+            SetActiveTab(window);
+
+            Arrange(changed, changed->Rect);
+            return true;
+        }
+
+        void    DockSpace::Undock(Window* window)
+        {
+            Leaves::const_iterator leafIt = mLeaves.find(window);
+
+            if (leafIt == mLeaves.end())
+                return;
+
+            for (std::vector<_DockedTab>::const_iterator it = leafIt->second->Tabs.begin(); it != leafIt->second->Tabs.end(); ++it)
+            {
+                if (it->Tab == window)
+                {
+                    window->SetMovableX(it->MovableX);
+                    window->SetMovableY(it->MovableY);
+                    break;
+                }
+            }
+
+            // The tab is forgotten first, Remove() doesn't find it again
+            RemoveTab(window);
+            Remove(window);
+            window->SetVisible(true);
+        }
+
+        void    DockSpace::RemoveTab(const Widget* window)
+        {
+            Leaves::iterator leafIt = mLeaves.find(window);
+
+            if (leafIt == mLeaves.end())
+                return;
+
+            Node* leaf = leafIt->second;
+            mLeaves.erase(leafIt);
+
+            for (std::vector<_DockedTab>::iterator it = leaf->Tabs.begin(); it != leaf->Tabs.end(); ++it)
+            {
+                if (it->Tab == window)
+                {
+                    leaf->Tabs.erase(it);
+                    break;
+                }
+            }
+
+            if (!leaf->Tabs.empty())
+            {
+                if (leaf->ActiveTab == window)
+                    SetActiveTab(leaf->Tabs.back().Tab);
+                return;
+            }
+
+            leaf->ActiveTab = 0;
+
+            if (leaf == mRoot)
+                return;
+
+            // The empty area is merged with its neighbour, which takes the whole split
+            Node* split = leaf->Parent;
+            Node* neighbour = (split->First == leaf) ? split->Second : split->First;
+
+            MoveNode(neighbour, split);
+            delete leaf;
+            delete neighbour;
+
+            Arrange(split, split->Rect);
+        }
+
+        bool    DockSpace::IsDocked(const Window* window) const
+        {
+            return (mLeaves.find(window) != mLeaves.end());
+        }
+
+        Window* DockSpace::GetActiveTab(const Window* window) const
+        {
+            Leaves::const_iterator it = mLeaves.find(window);
+
+            return (it != mLeaves.end()) ? it->second->ActiveTab : 0;
+        }
+
+        void    DockSpace::SetActiveTab(Window* window)
+        {
+            Leaves::const_iterator leafIt = mLeaves.find(window);
+
+            if (leafIt == mLeaves.end())
+                return;
+
+            Node* leaf = leafIt->second;
+
+            // Hidden tabs are skipped by the rendering and the hit-tests
+            for (std::vector<_DockedTab>::const_iterator it = leaf->Tabs.begin(); it != leaf->Tabs.end(); ++it)
+            {
+                if (it->Tab->IsVisible() != (it->Tab == window))
+                    it->Tab->SetVisible(it->Tab == window);
+            }
+
+            leaf->ActiveTab = window;
+            window->SetLayoutRect(leaf->Rect);
+        }
+
+        void    DockSpace::SetSplitRatio(const Window* window, float ratio)
+        {
+            Leaves::const_iterator it = mLeaves.find(window);
+
+            if (it == mLeaves.end() || !it->second->Parent)
+                return;
+
+            Node* leaf = it->second;
+            Node* split = leaf->Parent;
+
+            ratio = std::min(1.f, std::max(0.f, ratio));
+            split->Ratio = (split->First == leaf) ? ratio : 1.f - ratio;
+
+            Arrange(split, split->Rect);
+        }
+
+        float   DockSpace::GetSpacing() const
+        {
+            return mSpacing;
+        }
+
+        void    DockSpace::SetSpacing(float spacing)
+        {
+            mSpacing = spacing;
+            Arrange(mRoot, mRoot->Rect);
+        }
+
+        void    DockSpace::LoadStyle(const std::string& nameStyle)
+        {
+            ResourceManager* rm = ResourceManager::Get();
+            StyleProperties& properties = rm->GetStyle(nameStyle);
+
+            SetSpacing(rm->GetValue(properties["spacing"], GetSpacing()));
+
+            Widget::LoadStyle(nameStyle);
+        }
+
+        void    DockSpace::Arrange(Node* node, const FloatRect& rect)
+        {
+            node->Rect = rect;
+
+            if (!node->First)
+            {
+                if (node->ActiveTab)
+                    node->ActiveTab->SetLayoutRect(rect);
+                return;
+            }
+
+            if (node->Vertical)
+            {
+                const float middle = rect.Top + std::max(0.f, rect.GetSize().y - mSpacing) * node->Ratio;
+
+                Arrange(node->First, FloatRect(rect.Left, rect.Top, rect.Right, middle));
+                Arrange(node->Second, FloatRect(rect.Left, middle + mSpacing, rect.Right, rect.Bottom));
+            }
+            else
+            {
+                const float middle = rect.Left + std::max(0.f, rect.GetSize().x - mSpacing) * node->Ratio;
+
+                Arrange(node->First, FloatRect(rect.Left, rect.Top, middle, rect.Bottom));
+                Arrange(node->Second, FloatRect(middle + mSpacing, rect.Top, rect.Right, rect.Bottom));
+            }
+        }
+
+        void    DockSpace::OnChildRemoved(const Widget* child)
+        {
+            // A docked window deleted or given to another parent : only the tree is updated, the window may be half-destroyed
+            RemoveTab(child);
+        }
+
+        void    DockSpace::OnChange(Widget::Property property)
+        {
+            // The docked windows are placed by the splits, not by their alignment
+            if (property == Widget::SIZE)
+                Arrange(mRoot, FloatRect(0.f, 0.f, GetWidth(), GetHeight()));
+            else
+                Widget::OnChange(property);
+        }
+
+    }
+
+}
@@ -0,0 +1,450 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+#include <SFUI/EventRecorder.hpp>
+#include <SFUI/GuiRenderer.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        static const char           _RecordMagic[4] = { 'S', 'F', 'E', 'V' };
+
+        static const Uint8          _RecordVersion = 1;
+
+        static const Uint8          _FrameRecord = 0xFF;
+
+        static const size_t         _FlushSize = 64 * 1024;
+
+        /** Read cursor over a loaded record file */
+        class _RecordReader
+        {
+            public :
+
+                _RecordReader(const std::vector<Uint8>& data)
+                    :   mData(data),
+                        mPosition(0),
+                        mValid(true)
+                {}
+
+                bool    AtEnd() const
+                {
+                    return mPosition >= mData.size();
+                }
+
+                bool    IsValid() const
+                {
+                    return mValid;
+                }
+
+                Uint8   ReadByte()
+                {
+                    if (AtEnd())
+                    {
+                        mValid = false;
+                        return 0;
+                    }
+                    return mData[mPosition++];
+                }
+
+                Uint32  ReadUnsigned()
+                {
+                    Uint32 value = 0;
+
+                    for (unsigned int shift = 0; shift < 35 && mValid; shift += 7)
+                    {
+                        Uint8 byte = ReadByte();
+
+                        value |= static_cast<Uint32>(byte & 0x7F) << shift;
+                        if (!(byte & 0x80))
+                            return value;
+                    }
+                    mValid = false;
+                    return 0;
+                }
+
+                Int32   ReadSigned()
+                {
+                    Uint32 value = ReadUnsigned();
+
+                    return static_cast<Int32>(value >> 1) ^ -static_cast<Int32>(value & 1);
+                }
+
+            private :
+
+                const std::vector<Uint8>&   mData;
+
+                size_t                      mPosition;
+
+                bool                        mValid;
+        };
+
+        EventRecorder::EventRecorder()
+            :   mEventCount(0),
+                mMouseX(0),
+                mMouseY(0)
+        {
+
+        }
+
+        EventRecorder::~EventRecorder()
+        {
+            Close();
+        }
+
+        bool    EventRecorder::Open(const std::string& filename)
+        {
+            Close();
+
+            mFile.open(filename.c_str(), std::ios::binary | std::ios::trunc);
+
+            if (!mFile)
+            {
+                std::cerr << "Could not write \"" << filename << "\" record file" << std::endl;
+                return false;
+            }
+
+            mBuffer.assign(_RecordMagic, _RecordMagic + sizeof(_RecordMagic));
+            mBuffer.push_back(_RecordVersion);
+
+            mEventCount = 0;
+            mMouseX = mMouseY = 0;
+            mClock.Reset();
+
+            return true;
+        }
+
+        void    EventRecorder::Close()
+        {
+            if (!mFile.is_open())
+                return;
+
+            if (!mBuffer.empty())
+                mFile.write(reinterpret_cast<const char*>(&mBuffer[0]), mBuffer.size());
+
+            mBuffer.clear();
+            mFile.close();
+        }
+
+        bool    EventRecorder::IsOpen() const
+        {
+            return mFile.is_open();
+        }
+
+        unsigned int    EventRecorder::GetEventCount() const
+        {
+            return mEventCount;
+        }
+
+        void    EventRecorder::WriteUnsigned(Uint32 value)
+        {
+            while (value >= 0x80)
+            {
+                mBuffer.push_back(static_cast<Uint8>(value | 0x80));
+                value >>= 7;
+            }
+            mBuffer.push_back(static_cast<Uint8>(value));
+        }
+
+        void    EventRecorder::WriteSigned(Int32 value)
+        {
+            // Zigzag encoding : small negative values stay small
+            WriteUnsigned((static_cast<Uint32>(value) << 1) ^ static_cast<Uint32>(value >> 31));
+        }
+
+        void    EventRecorder::WriteHeader(Uint8 type)
+        {
+            mBuffer.push_back(type);
+            WriteUnsigned(static_cast<Uint32>(mClock.GetElapsedTime() * 1000.f));
+            mClock.Reset();
+        }
+
+        void    EventRecorder::RecordFrame()
+        {
+            if (!mFile.is_open())
+                return;
+
+            WriteHeader(_FrameRecord);
+        }
+
+        void    EventRecorder::Record(const Event& event)
+        {
+            if (!mFile.is_open())
+                return;
+
+            WriteHeader(static_cast<Uint8>(event.Type));
+
+            switch (event.Type)
+            {
+                case Event::Resized :
+                    WriteUnsigned(event.Size.Width);
+                    WriteUnsigned(event.Size.Height);
+                break;
+
+                case Event::TextEntered :
+                    WriteUnsigned(event.Text.Unicode);
+                break;
+
+                case Event::KeyPressed :
+                case Event::KeyReleased :
+                    WriteUnsigned(event.Key.Code);
+                    mBuffer.push_back((event.Key.Alt ? 1 : 0) | (event.Key.Control ? 2 : 0) | (event.Key.Shift ? 4 : 0));
+                break;
+
+                case Event::MouseWheelMoved :
+                    WriteSigned(event.MouseWheel.Delta);
+                break;
+
+                case Event::MouseButtonPressed :
+                case Event::MouseButtonReleased :
+                    mBuffer.push_back(static_cast<Uint8>(event.MouseButton.Button));
+                    WriteSigned(event.MouseButton.X - mMouseX);
+                    WriteSigned(event.MouseButton.Y - mMouseY);
+                    mMouseX = event.MouseButton.X;
+                    mMouseY = event.MouseButton.Y;
+                break;
+
+                case Event::MouseMoved :
+                    WriteSigned(event.MouseMove.X - mMouseX);
+                    WriteSigned(event.MouseMove.Y - mMouseY);
+                    mMouseX = event.MouseMove.X;
+                    mMouseY = event.MouseMove.Y;
+                break;
+
+                case Event::JoyButtonPressed :
+                case Event::JoyButtonReleased :
+                    WriteUnsigned(event.JoyButton.JoystickId);
+                    WriteUnsigned(event.JoyButton.Button);
+                break;
+
+                case Event::JoyMoved :
+                    WriteUnsigned(event.JoyMove.JoystickId);
+                    WriteUnsigned(event.JoyMove.Axis);
+                    WriteSigned(static_cast<Int32>(event.JoyMove.Position * 100.f));
+                break;
+
+                default :
+                break;
+            }
+
+            ++mEventCount;
+
+            if (mBuffer.size() >= _FlushSize)
+            {
+                mFile.write(reinterpret_cast<const char*>(&mBuffer[0]), mBuffer.size());
+                mBuffer.clear();
+            }
+        }
+
+        EventPlayer::EventPlayer()
+            :   mEventCount(0)
+        {
+
+        }
+
+        bool    EventPlayer::LoadFromFile(const std::string& filename)
+        {
+            std::ifstream file(filename.c_str(), std::ios::binary);
+
+            if (!file)
+            {
+                std::cerr << "Could not load \"" << filename << "\" record file" << std::endl;
+                return false;
+            }
+
+            std::vector<Uint8> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            if (data.size() < sizeof(_RecordMagic) + 1 ||
+                std::memcmp(&data[0], _RecordMagic, sizeof(_RecordMagic)) != 0 || data[sizeof(_RecordMagic)] != _RecordVersion)
+            {
+                std::cerr << "\"" << filename << "\" is not a valid record file" << std::endl;
+                return false;
+            }
+
+            _RecordReader reader(data);
+            int mouseX = 0, mouseY = 0;
+
+            for (size_t i = 0; i < sizeof(_RecordMagic) + 1; ++i)
+                reader.ReadByte();
+
+            mEntries.clear();
+            mEventCount = 0;
+
+            while (!reader.AtEnd() && reader.IsValid())
+            {
+                Entry entry;
+                Uint8 type = reader.ReadByte();
+
+                std::memset(&entry.Evt, 0, sizeof(entry.Evt));
+                entry.Frame = (type == _FrameRecord);
+                entry.Evt.Type = static_cast<Event::EventType>(type);
+
+                // Record times are not used, events are replayed as fast as possible
+                reader.ReadUnsigned();
+
+                if (entry.Frame)
+                {
+                    mEntries.push_back(entry);
+                    continue;
+                }
+
+                Event& event = entry.Evt;
+
+                switch (event.Type)
+                {
+                    case Event::Resized :
+                        event.Size.Width = reader.ReadUnsigned();
+                        event.Size.Height = reader.ReadUnsigned();
+                    break;
+
+                    case Event::TextEntered :
+                        event.Text.Unicode = reader.ReadUnsigned();
+                    break;
+
+                    case Event::KeyPressed :
+                    case Event::KeyReleased :
+                    {
+                        event.Key.Code = static_cast<Key::Code>(reader.ReadUnsigned());
+
+                        Uint8 modifiers = reader.ReadByte();
+
+                        event.Key.Alt = (modifiers & 1) != 0;
+                        event.Key.Control = (modifiers & 2) != 0;
+                        event.Key.Shift = (modifiers & 4) != 0;
+                    }
+                    break;
+
+                    case Event::MouseWheelMoved :
+                        event.MouseWheel.Delta = reader.ReadSigned();
+                    break;
+
+                    case Event::MouseButtonPressed :
+                    case Event::MouseButtonReleased :
+                        event.MouseButton.Button = static_cast<Mouse::Button>(reader.ReadByte());
+                        event.MouseButton.X = mouseX += reader.ReadSigned();
+                        event.MouseButton.Y = mouseY += reader.ReadSigned();
+                    break;
+
+                    case Event::MouseMoved :
+                        event.MouseMove.X = mouseX += reader.ReadSigned();
+                        event.MouseMove.Y = mouseY += reader.ReadSigned();
+                    break;
+
+                    case Event::JoyButtonPressed :
+                    case Event::JoyButtonReleased :
+                        event.JoyButton.JoystickId = reader.ReadUnsigned();
+                        event.JoyButton.Button = reader.ReadUnsigned();
+                    break;
+
+                    case Event::JoyMoved :
+                        event.JoyMove.JoystickId = reader.ReadUnsigned();
+                        event.JoyMove.Axis = static_cast<Joy::Axis>(reader.ReadUnsigned());
+                        event.JoyMove.Position = reader.ReadSigned() / 100.f;
+                    break;
+
+                    default :
+                    break;
+                }
+
+                if (reader.IsValid())
+                {
+                    mEntries.push_back(entry);
+                    ++mEventCount;
+                }
+            }
+
+            if (!reader.IsValid())
+                std::cerr << "\"" << filename << "\" record file is truncated" << std::endl;
+
+            return true;
+        }
+
+        unsigned int    EventPlayer::GetEventCount() const
+        {
+            return mEventCount;
+        }
+
+        unsigned int    EventPlayer::GetFrameCount() const
+        {
+            return static_cast<unsigned int>(mEntries.size()) - mEventCount;
+        }
+
+        ReplayStats     EventPlayer::Play(GuiRenderer& gui, bool display) const
+        {
+            ReplayStats stats = { 0, 0, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+            std::vector<float> latencies;
+            Clock clock;
+
+            latencies.reserve(mEventCount);
+
+            for (std::vector<Entry>::const_iterator it = mEntries.begin(); it != mEntries.end(); ++it)
+            {
+                if (it->Frame)
+                {
+                    if (display)
+                    {
+                        gui.Display();
+                        ++stats.FrameCount;
+                    }
+                    continue;
+                }
+
+                clock.Reset();
+                gui.InjectEvent(it->Evt);
+                latencies.push_back(clock.GetElapsedTime());
+            }
+
+            if (latencies.empty())
+                return stats;
+
+            stats.EventCount = static_cast<unsigned int>(latencies.size());
+
+            for (std::vector<float>::const_iterator it = latencies.begin(); it != latencies.end(); ++it)
+                stats.TotalTime += *it;
+
+            std::sort(latencies.begin(), latencies.end());
+
+            const size_t last = latencies.size() - 1;
+
+            stats.Mean = stats.TotalTime / latencies.size();
+            stats.P50 = latencies[last * 50 / 100];
+            stats.P90 = latencies[last * 90 / 100];
+            stats.P99 = latencies[last * 99 / 100];
+            stats.Max = latencies[last];
+
+            return stats;
+        }
+
+    }
+
+}
@@ -0,0 +1,163 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+#include <iostream>
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/Lock.hpp>
+
+#include <SFUI/GlyphAtlas.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        static const unsigned int   _atlasWidth = 1024;
+        static const unsigned int   _initialHeight = 128;
+        static const unsigned int   _maximumHeight = 4096;
+
+        GlyphAtlas::GlyphAtlas()
+            :   mAccess(),
+                mDirty(),
+                mGlyphCount(0),
+                mHeight(_initialHeight),
+                mImage(),
+                mModified(true),
+                mPixels(_atlasWidth * _initialHeight * 4, 255),
+                mRowHeight(0),
+                mUpload(),
+                mX(1),
+                mY(1)
+        {
+            for (unsigned int i = 0; i < _atlasWidth * mHeight; ++i)
+                mPixels[4 * i + 3] = 0;
+        }
+
+        IntRect     GlyphAtlas::Add(unsigned int width, unsigned int height, const Uint8* coverage)
+        {
+            if (width + 2 > _atlasWidth)
+            {
+                std::cerr << "Could not add a " << width << "x" << height << " glyph, it is wider than the glyph atlas" << std::endl;
+                return IntRect();
+            }
+
+            Lock lock(mAccess);
+
+            // Shelf packing, with one pixel between glyphs
+            if (mX + width + 1 > _atlasWidth)
+            {
+                mX = 1;
+                mY += mRowHeight + 1;
+                mRowHeight = 0;
+            }
+
+            while (mY + height + 1 > mHeight)
+            {
+                if (mHeight * 2 > _maximumHeight)
+                {
+                    std::cerr << "Could not add a " << width << "x" << height << " glyph, the glyph atlas is full" << std::endl;
+                    return IntRect();
+                }
+
+                // The new rows are transparent
+                mPixels.resize(_atlasWidth * mHeight * 2 * 4, 255);
+
+                for (unsigned int i = _atlasWidth * mHeight; i < _atlasWidth * mHeight * 2; ++i)
+                    mPixels[4 * i + 3] = 0;
+
+                mHeight *= 2;
+            }
+
+            const IntRect rect(mX, mY, mX + width, mY + height);
+
+            for (unsigned int y = 0; y < height; ++y)
+            {
+                for (unsigned int x = 0; x < width; ++x)
+                    mPixels[4 * ((rect.Top + y) * _atlasWidth + rect.Left + x) + 3] = coverage[y * width + x];
+            }
+
+            // The rows of the glyph are uploaded with the next image request
+            if (mModified && mDirty.Bottom > mDirty.Top)
+            {
+                mDirty.Top = std::min(mDirty.Top, rect.Top);
+                mDirty.Bottom = std::max(mDirty.Bottom, rect.Bottom);
+            }
+            else
+            {
+                mDirty = IntRect(0, rect.Top, _atlasWidth, rect.Bottom);
+            }
+
+            mX += width + 1;
+            mRowHeight = std::max(mRowHeight, static_cast<int>(height));
+            mModified = true;
+            ++mGlyphCount;
+
+            return rect;
+        }
+
+        unsigned int    GlyphAtlas::GetGlyphCount() const
+        {
+            Lock lock(mAccess);
+            return mGlyphCount;
+        }
+
+        const Image&    GlyphAtlas::GetImage(RenderTarget* target) const
+        {
+            Lock lock(mAccess);
+
+            if (!mModified)
+                return mImage;
+
+            if (mImage.GetHeight() != mHeight)
+            {
+                // Queued vertices have texture coordinates relative to the former size
+                if (target && mImage.GetHeight() > 0)
+                    target->Flush();
+
+                mImage.LoadFromPixels(_atlasWidth, mHeight, &mPixels[0]);
+            }
+            else if (mDirty.Bottom > mDirty.Top)
+            {
+                // Only the full-width rows of the new glyphs are sent, they are contiguous in memory
+                const unsigned int first = 4 * mDirty.Top * _atlasWidth;
+                const unsigned int last = 4 * mDirty.Bottom * _atlasWidth;
+
+                mUpload.assign(mPixels.begin() + first, mPixels.begin() + last);
+                mImage.UpdatePixels(&mUpload[0], mDirty);
+            }
+
+            mDirty = IntRect();
+            mModified = false;
+
+            return mImage;
+        }
+
+    }
+
+}
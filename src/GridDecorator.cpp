@@ -26,29 +26,34 @@
 
 */
 
+#include <algorithm>
+
 #include <SFUI/GridDecorator.hpp>
+#include <SFUI/Painter.hpp>
 
 namespace sf
 {
     namespace ui
     {
+        /** Style suffix of each part, row by row */
+        static const char*  _partNames[9] =
+        {
+            "->topLeft",    "->topCenter",      "->topRight",
+            "->left",       "->center",         "->right",
+            "->bottomLeft", "->bottomCenter",   "->bottomRight"
+        };
 
         GridDecorator::GridDecorator()
-            :   Icon()
+            :   Icon(),
+                mUseGrid(true)
         {
             SetDefaultStyle("BI_GridDecorator");
-            LoadStyle(GetDefaultStyle());
-
-            for (unsigned int i = Align::TOP_LEFT; i <= Align::BOTTOM_RIGHT; ++i)
-                Add(&mIcons[i]);
+            LoadStyle(GetInitialStyle());
         }
 
         void    GridDecorator::UseGrid(bool useGrid)
         {
             mUseGrid = useGrid;
-
-            for (unsigned int i = Align::TOP_LEFT; i <= Align::BOTTOM_RIGHT; ++i)
-                mIcons[i].SetVisible(useGrid);
         }
 
         bool    GridDecorator::IsGridUsed() const
@@ -63,32 +68,98 @@ namespace sf
 
             UseGrid(rm->GetValue(properties["useGrid"], IsGridUsed()));
 
-            mIcons[Align::TOP_LEFT].LoadStyle(nameStyle + "->topLeft");
-            mIcons[Align::TOP_CENTER].LoadStyle(nameStyle + "->topCenter");
-            mIcons[Align::TOP_RIGHT].LoadStyle(nameStyle + "->topRight");
+            // Parts of the previous style are not kept : a part without image in the new style is empty
+            for (unsigned int i = 0; i < 9; ++i)
+            {
+                mParts[i] = Sprite();
+                mPartSizes[i] = Vector2f(0.f, 0.f);
+            }
 
-            mIcons[Align::LEFT].LoadStyle(nameStyle + "->left");
-            mIcons[Align::CENTER].LoadStyle(nameStyle + "->center");
-            mIcons[Align::RIGHT].LoadStyle(nameStyle + "->right");
+            // Inherited styles are loaded by Icon::LoadStyle(), parts of this style override theirs
+            Icon::LoadStyle(nameStyle);
 
-            mIcons[Align::BOTTOM_LEFT].LoadStyle(nameStyle + "->bottomLeft");
-            mIcons[Align::BOTTOM_CENTER].LoadStyle(nameStyle + "->bottomCenter");
-            mIcons[Align::BOTTOM_RIGHT].LoadStyle(nameStyle + "->bottomRight");
+            for (unsigned int i = 0; i < 9; ++i)
+                LoadPartStyle(i, nameStyle + _partNames[i]);
 
-            Icon::LoadStyle(nameStyle);
+            UpdateParts();
+        }
+
+        void    GridDecorator::LoadPartStyle(unsigned int part, const std::string& nameStyle)
+        {
+            ResourceManager* rm = ResourceManager::Get();
+            StyleProperties& properties = rm->GetStyle(nameStyle);
+
+            if (properties["from"] != "")
+                LoadPartStyle(part, properties["from"]);
+
+            if (properties["image"] != "")
+            {
+                mParts[part] = rm->GetImage(properties["image"]);
+
+                const IntRect& rect = mParts[part].GetSubRect();
+                mPartSizes[part] = Vector2f(rect.Right - rect.Left, rect.Bottom - rect.Top);
+            }
+
+            mPartSizes[part].x = rm->GetValue(properties["width"], mPartSizes[part].x);
+            mPartSizes[part].y = rm->GetValue(properties["height"], mPartSizes[part].y);
+        }
+
+        void    GridDecorator::UpdateParts()
+        {
+            const Vector2f* sizes = mPartSizes;
+            const float width = GetWidth();
+            const float height = GetHeight();
+
+            // Corners keep their size, the other parts fill the space between their neighbours
+            const FloatRect rects[9] =
+            {
+                FloatRect(0.f, 0.f, sizes[0].x, sizes[0].y),
+                FloatRect(sizes[0].x, 0.f, width - sizes[2].x, sizes[1].y),
+                FloatRect(width - sizes[2].x, 0.f, width, sizes[2].y),
+
+                FloatRect(0.f, sizes[0].y, sizes[3].x, height - sizes[6].y),
+                FloatRect(sizes[3].x, sizes[1].y, width - sizes[5].x, height - sizes[7].y),
+                FloatRect(width - sizes[5].x, sizes[2].y, width, height - sizes[8].y),
+
+                FloatRect(0.f, height - sizes[6].y, sizes[6].x, height),
+                FloatRect(sizes[6].x, height - sizes[7].y, width - sizes[8].x, height),
+                FloatRect(width - sizes[8].x, height - sizes[8].y, width, height)
+            };
+
+            // The slice is used when all parts come from the same image
+            const Image* image = 0;
+            bool sameImage = true;
+
+            for (unsigned int i = 0; i < 9; ++i)
+            {
+                const Image* partImage = mParts[i].GetImage();
+
+                if (!partImage)
+                {
+                    mSlice.SetPart(i % 3, i / 3, IntRect(), FloatRect());
+                    continue;
+                }
+
+                if (image && partImage != image)
+                    sameImage = false;
+                image = partImage;
+
+                const FloatRect& rect = rects[i];
+
+                mParts[i].SetPosition(rect.Left, rect.Top);
+                mParts[i].Resize(std::max(0.f, rect.GetSize().x), std::max(0.f, rect.GetSize().y));
+
+                mSlice.SetPart(i % 3, i / 3, mParts[i].GetSubRect(), rect);
+            }
+
+            mSlice.SetImage(sameImage ? image : 0);
         }
 
         void    GridDecorator::OnChange(Widget::Property property)
         {
             if (property == Widget::SIZE)
             {
-                mIcons[Align::TOP_CENTER].SetWidth(GetWidth() - (mIcons[Align::TOP_LEFT].GetWidth() + mIcons[Align::TOP_RIGHT].GetWidth()));
-                mIcons[Align::CENTER].SetWidth(GetWidth() - (mIcons[Align::LEFT].GetWidth() + mIcons[Align::RIGHT].GetWidth()));
-                mIcons[Align::BOTTOM_CENTER].SetWidth(GetWidth() - (mIcons[Align::BOTTOM_LEFT].GetWidth() + mIcons[Align::BOTTOM_RIGHT].GetWidth()));
-
-                mIcons[Align::LEFT].SetHeight(GetHeight() - (mIcons[Align::TOP_LEFT].GetHeight() + mIcons[Align::BOTTOM_LEFT].GetHeight()));
-                mIcons[Align::CENTER].SetHeight(GetHeight() - (mIcons[Align::TOP_CENTER].GetHeight() + mIcons[Align::BOTTOM_CENTER].GetHeight()));
-                mIcons[Align::RIGHT].SetHeight(GetHeight() - (mIcons[Align::TOP_RIGHT].GetHeight() + mIcons[Align::BOTTOM_RIGHT].GetHeight()));
+                UpdateParts();
             }
             else if (property == Widget::PARENT)
             {
@@ -102,5 +173,26 @@ namespace sf
             }
             Icon::OnChange(property);
         }
+
+        void    GridDecorator::OnPaint(Painter& painter) const
+        {
+            Icon::OnPaint(painter);
+
+            if (!mUseGrid)
+                return;
+
+            if (mSlice.GetImage())
+            {
+                painter.DrawNineSlice(mSlice);
+                return;
+            }
+
+            // Parts from different images are drawn one by one
+            for (unsigned int i = 0; i < 9; ++i)
+            {
+                if (mParts[i].GetImage())
+                    painter.DrawSprite(mParts[i]);
+            }
+        }
     }
 }
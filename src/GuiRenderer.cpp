@@ -26,31 +26,59 @@
 
 */
 
+#include <SFUI/EventRecorder.hpp>
 #include <SFUI/GuiRenderer.hpp>
 
+#include <SFUI/Profiler.hpp>
 #include <SFUI/ResourceManager.hpp>
+#include <SFUI/TaskPool.hpp>
 #include <SFML/Graphics/RenderQueue.hpp>
+#include <SFML/System/Thread.hpp>
+
+#include <iostream>
 
 namespace sf
 {
     namespace ui
     {
-        GuiRenderer::GuiRenderer(sf::RenderWindow& renderWindow)
-            :   mView(Vector2f(0.f, 0.f), Vector2f(renderWindow.GetWidth(), renderWindow.GetHeight())),
-                mRenderWindow(renderWindow),
-                mMouseInside(true)
+        GuiRenderer::GuiRenderer(sf::RenderTarget& renderTarget)
+            :   mView(Vector2f(0.f, 0.f), Vector2f(renderTarget.GetWidth(), renderTarget.GetHeight())),
+                mAnimations(),
+                mClearColor(0, 0, 0),
+                mFrameDrawn(1),
+                mFrameSubmitted(0),
+                mMouseInside(true),
+                mRecorder(0),
+                mRecordedFrame(0),
+                mRenderTarget(renderTarget),
+                mRenderThread(0),
+                mStopRendering(false),
+                mSubmittedFrame(0)
         {
-            SetSize(renderWindow.GetWidth(), renderWindow.GetHeight());
+            SetSize(renderTarget.GetWidth(), renderTarget.GetHeight());
             SetColor(Color(0, 0, 0, 0));
 
-            Widget::mFocusedWidget = Widget::mHoveredWidget = this;
+            Widget::mFocusedWidget = Widget::mHoveredWidget = Widget::mLastHovered = this;
+            Widget::mAnimator = &mAnimations;
         }
 
         GuiRenderer::~GuiRenderer()
         {
+            EnableRenderThread(false);
+
+            delete Widget::mTaskPool;
+            Widget::mTaskPool = 0;
+            if (Widget::mAnimator == &mAnimations)
+                Widget::mAnimator = 0;
+
             ResourceManager::Kill();
         }
 
+        void    GuiRenderer::SetEventRecorder(EventRecorder* recorder)
+        {
+            mRecorder = recorder;
+        }
+
         void    GuiRenderer::SetFocusedWidget(Widget* widget)
         {
             Widget::mFocusedWidget = widget;
@@ -68,12 +96,8 @@ namespace sf
 
         void    GuiRenderer::SetHoveredWidget(Widget* widget, const Vector2ui& mouse, Vector2f absPos)
         {
-            Widgets&  widgets = widget->mChildren;
-
-            for (Widgets::reverse_iterator it = widgets.rbegin(); it != widgets.rend(); ++it)
+            for (Widget* currentWidget = widget->mLastChild; currentWidget; currentWidget = currentWidget->mPrevSibling)
             {
-                Widget* currentWidget = *it;
-
                 if (currentWidget->IsVisible() && currentWidget->IsFocusable())
                 {
                     absPos += currentWidget->GetPosition();
@@ -92,6 +116,11 @@ namespace sf
 
         void    GuiRenderer::InjectEvent(const Event& event)
         {
+            ProfileScope scope(Profiler::INJECT_EVENT);
+
+            if (mRecorder)
+                mRecorder->Record(event);
+
             // We left the injection for unwanted events
             if (event.Type == Event::MouseEntered || event.Type == Event::MouseLeft ||
                 event.Type == Event::GainedFocus || event.Type == Event::LostFocus)
@@ -112,22 +141,22 @@ namespace sf
             // Set the hovered widget
             else if (event.Type == Event::MouseMoved)
             {
-                static Widget*  lastHovered = this;
-
                 Widget::mHoveredWidget = this;
                 SetHoveredWidget(this, Vector2ui(event.MouseMove.X, event.MouseMove.Y), GetPosition());
 
-                if (lastHovered != Widget::mHoveredWidget)
+                // The last hovered widget is reset by its destructor
+                if (Widget::mLastHovered != Widget::mHoveredWidget)
                 {
                     sf::Event newEvent = event;
 
                     newEvent.Type = Event::MouseLeft;
-                    lastHovered->DistributeEvent(newEvent);
+                    if (Widget::mLastHovered)
+                        Widget::mLastHovered->DistributeEvent(newEvent);
 
                     newEvent.Type = Event::MouseEntered;
                     Widget::mHoveredWidget->DistributeEvent(newEvent);
 
-                    lastHovered = Widget::mHoveredWidget;
+                    Widget::mLastHovered = Widget::mHoveredWidget;
                 }
             }
             if (Widget::mFocusedWidget)
@@ -150,13 +179,128 @@ namespace sf
 
         void    GuiRenderer::Display()
         {
-            const View& otherView = mRenderWindow.GetView();
+            {
+                ProfileScope scope(Profiler::DISPLAY);
+
+                if (Widget::mTaskPool)
+                    Widget::mTaskPool->Dispatch();
+
+                // Animated sizes update the layout before the styles and the drawing
+                mAnimations.Update(mFrameClock.GetElapsedTime());
+                mFrameClock.Reset();
+
+                ResourceManager::Get()->ReloadChangedStyles();
 
-            mRenderWindow.SetView(mView);
+                // Only the widgets changed since the last frame are laid out again
+                UpdateLayout();
 
-            mRenderWindow.Draw(*this);
+                if (mRenderThread)
+                {
+                    mFrames[mRecordedFrame].Record(*this);
+                    mFrameViews[mRecordedFrame] = mView;
+
+                    // The other list may still be drawn, it is the next one to be recorded
+                    mFrameDrawn.Wait();
+                    mSubmittedFrame = mRecordedFrame;
+                    mFrameSubmitted.Post();
+
+                    mRecordedFrame = 1 - mRecordedFrame;
+                }
+                else
+                {
+                    const View& otherView = mRenderTarget.GetView();
+
+                    mRenderTarget.SetView(mView);
+
+                    mRenderTarget.Draw(*this);
+
+                    mRenderTarget.SetView(otherView);
+                }
+            }
+
+            if (mRecorder)
+                mRecorder->RecordFrame();
+
+            Profiler::EndFrame();
+        }
+
+        bool    GuiRenderer::EnableRenderThread(bool enable, const Color& clearColor)
+        {
+            mClearColor = clearColor;
 
-            mRenderWindow.SetView(otherView);
+            if (enable == (mRenderThread != 0))
+                return enable;
+
+            RenderWindow* window = dynamic_cast<RenderWindow*>(&mRenderTarget);
+
+            if (!window)
+            {
+                std::cerr << "The render thread needs a sf::RenderWindow target" << std::endl;
+                return false;
+            }
+
+            if (enable)
+            {
+                // The rendering context moves to the render thread
+                window->SetActive(false);
+
+                mStopRendering = false;
+                mRenderThread = new Thread(&GuiRenderer::RenderFrames, this);
+                mRenderThread->Launch();
+                return true;
+            }
+
+            // The frame submitted last is drawn before the render thread stops
+            mFrameDrawn.Wait();
+            mStopRendering = true;
+            mFrameSubmitted.Post();
+
+            mRenderThread->Wait();
+            delete mRenderThread;
+            mRenderThread = 0;
+            mFrameDrawn.Post();
+
+            window->SetActive(true);
+            return false;
+        }
+
+        bool    GuiRenderer::IsRenderThreadEnabled() const
+        {
+            return (mRenderThread != 0);
+        }
+
+        void    GuiRenderer::RenderFrames(void* userData)
+        {
+            GuiRenderer* gui = static_cast<GuiRenderer*>(userData);
+            RenderWindow& window = static_cast<RenderWindow&>(gui->mRenderTarget);
+
+            window.SetActive(true);
+
+            while (true)
+            {
+                // The semaphores order the accesses to the frames, the thread sleeps until one is submitted
+                gui->mFrameSubmitted.Wait();
+
+                if (gui->mStopRendering)
+                    break;
+
+                const unsigned int frame = gui->mSubmittedFrame;
+
+                // Only the recorded list is read, widgets are updated meanwhile
+                window.Clear(gui->mClearColor);
+                window.SetView(gui->mFrameViews[frame]);
+                window.Draw(gui->mFrames[frame]);
+                window.Display();
+
+                gui->mFrameDrawn.Post();
+            }
+
+            window.SetActive(false);
+        }
+
+        bool    GuiRenderer::SwitchTheme(const std::string& filename, PreloadStats* stats)
+        {
+            return ResourceManager::Get()->SwitchTheme(filename, stats);
         }
 
     }
@@ -29,6 +29,7 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 
 #include <SFUI/Icon.hpp>
+#include <SFUI/Painter.hpp>
 
 namespace sf
 {
@@ -39,7 +40,7 @@ namespace sf
                 mSprite()
         {
             SetDefaultStyle("BI_Icon");
-            LoadStyle(GetDefaultStyle());
+            LoadStyle(GetInitialStyle());
         }
 
         void    Icon::LoadStyle(const std::string& nameStyle)
@@ -96,15 +97,12 @@ namespace sf
             }
         }
 
-        void    Icon::OnPaint(RenderTarget& target, RenderQueue& queue) const
+        void    Icon::OnPaint(Painter& painter) const
         {
-            Widget::OnPaint(target, queue);
+            Widget::OnPaint(painter);
 
             if (mSprite.GetImage())
-            {
-                queue.SetColor(mSprite.GetColor());
-                target.Draw(mSprite);
-            }
+                painter.DrawSprite(mSprite);
         }
 
     }
@@ -29,6 +29,7 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 
 #include <SFUI/Label.hpp>
+#include <SFUI/Painter.hpp>
 #include <SFUI/ResourceManager.hpp>
 
 namespace sf
@@ -41,7 +42,7 @@ namespace sf
                 mCaption(caption, Font::GetDefaultFont(), 30.f)
         {
             SetDefaultStyle("BI_Label");
-            LoadStyle(GetDefaultStyle());
+            LoadStyle(GetInitialStyle());
         }
 
         void    Label::SetText(const Unicode::Text& caption)
@@ -112,7 +113,13 @@ namespace sf
 
             SetTextColor(rm->GetColorValue(properties["textColor"], GetTextColor()));
 
-            Font* newFont = rm->GetFont(properties["font"], GetTextSize());
+            // The font is requested at the style text size, or at the size of its alias
+            const float textSize = rm->GetValue(properties["textSize"], 0.f);
+
+            if (textSize > 0.f)
+                mCaption.SetSize(textSize);
+
+            Font* newFont = rm->GetFont(properties["font"], textSize);
             if (newFont)
             {
                 SetFont(*newFont);
@@ -120,8 +127,6 @@ namespace sf
 
             if (properties["textSize"] != "")
             {
-                mCaption.SetSize(rm->GetValue(properties["textSize"], GetTextSize()));
-
                 const Vector2f& strSize = mCaption.GetRect().GetSize();
 
                 if (properties["width"] == "")
@@ -133,12 +138,11 @@ namespace sf
             Widget::LoadStyle(nameStyle);
         }
 
-        void    Label::OnPaint(RenderTarget& target, RenderQueue& queue) const
+        void    Label::OnPaint(Painter& painter) const
         {
-            Widget::OnPaint(target, queue);
+            Widget::OnPaint(painter);
 
-            queue.SetColor(GetTextColor());
-            target.Draw(mCaption);
+            painter.DrawString(mCaption);
         }
     }
 }
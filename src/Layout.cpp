@@ -0,0 +1,374 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <SFUI/Layout.hpp>
+#include <SFUI/Profiler.hpp>
+
+#include <algorithm>
+
+namespace sf
+{
+    namespace ui
+    {
+        Layout::Layout()
+            :   Widget(),
+                mFitContent(true),
+                mPadding(0.f),
+                mSpacing(0.f)
+        {
+
+        }
+
+        float   Layout::GetPadding() const
+        {
+            return mPadding;
+        }
+
+        float   Layout::GetSpacing() const
+        {
+            return mSpacing;
+        }
+
+        bool    Layout::IsFittingContent() const
+        {
+            return mFitContent;
+        }
+
+        void    Layout::SetFitContent(bool fit)
+        {
+            mFitContent = fit;
+            InvalidateMeasure();
+        }
+
+        void    Layout::SetPadding(float padding)
+        {
+            mPadding = padding;
+            InvalidateMeasure();
+        }
+
+        void    Layout::SetSpacing(float spacing)
+        {
+            mSpacing = spacing;
+            InvalidateMeasure();
+        }
+
+        void    Layout::LoadStyle(const std::string& nameStyle)
+        {
+            ResourceManager* rm = ResourceManager::Get();
+            StyleProperties& properties = rm->GetStyle(nameStyle);
+
+            SetFitContent(rm->GetValue(properties["fitContent"], IsFittingContent()));
+            SetPadding(rm->GetValue(properties["padding"], GetPadding()));
+            SetSpacing(rm->GetValue(properties["spacing"], GetSpacing()));
+
+            Widget::LoadStyle(nameStyle);
+        }
+
+        void    Layout::OnChange(Widget::Property property)
+        {
+            // The children are placed by the layout, not by their alignment, once per frame
+            if (property == Widget::SIZE)
+                InvalidateLayout();
+            else
+                Widget::OnChange(property);
+        }
+
+        void    Layout::OnLayout()
+        {
+            ProfileScope scope(Profiler::LAYOUT, this);
+            const Vector2f& measured = GetMeasuredSize();
+
+            // A layout placed by another one keeps the size given by its parent
+            if (mFitContent && !dynamic_cast<const Layout*>(GetParent()) &&
+                (measured.x != GetWidth() || measured.y != GetHeight()))
+            {
+                const Vector2f& position = GetPosition();
+
+                SetLayoutRect(FloatRect(position.x, position.y, position.x + measured.x, position.y + measured.y));
+            }
+
+            Arrange();
+        }
+
+        BoxLayout::BoxLayout(Direction direction)
+            :   Layout(),
+                mStretch(false),
+                mDirection(direction)
+        {
+
+        }
+
+        BoxLayout::Direction    BoxLayout::GetDirection() const
+        {
+            return mDirection;
+        }
+
+        float   BoxLayout::GetGrowFactor(const Widget&) const
+        {
+            return 0.f;
+        }
+
+        Vector2f    BoxLayout::OnMeasure() const
+        {
+            const bool vertical = (mDirection == VERTICAL);
+            float length = 0.f;
+            float breadth = 0.f;
+            unsigned int count = 0;
+
+            for (Widget* child = GetFirstChild(); child; child = child->GetNextSibling())
+            {
+                if (!child->IsVisible())
+                    continue;
+
+                const Vector2f& size = child->GetMeasuredSize();
+
+                length += vertical ? size.y : size.x;
+                breadth = std::max(breadth, vertical ? size.x : size.y);
+                ++count;
+            }
+
+            if (count > 1)
+                length += GetSpacing() * (count - 1);
+
+            length += 2.f * GetPadding();
+            breadth += 2.f * GetPadding();
+
+            return vertical ? Vector2f(breadth, length) : Vector2f(length, breadth);
+        }
+
+        void    BoxLayout::Arrange()
+        {
+            const bool vertical = (mDirection == VERTICAL);
+            const float padding = GetPadding();
+            const Vector2f& measured = GetMeasuredSize();
+
+            // The free space is shared between the growing children
+            const float freeSpace = vertical ? GetHeight() - measured.y : GetWidth() - measured.x;
+            const float boxBreadth = (vertical ? GetWidth() : GetHeight()) - 2.f * padding;
+            float totalGrow = 0.f;
+
+            if (freeSpace > 0.f)
+            {
+                for (Widget* child = GetFirstChild(); child; child = child->GetNextSibling())
+                {
+                    if (child->IsVisible())
+                        totalGrow += GetGrowFactor(*child);
+                }
+            }
+
+            float position = padding;
+
+            for (Widget* child = GetFirstChild(); child; child = child->GetNextSibling())
+            {
+                if (!child->IsVisible())
+                    continue;
+
+                const Vector2f& size = child->GetMeasuredSize();
+                float length = vertical ? size.y : size.x;
+                const float breadth = mStretch ? boxBreadth : (vertical ? size.x : size.y);
+
+                if (totalGrow > 0.f)
+                    length += freeSpace * GetGrowFactor(*child) / totalGrow;
+
+                if (vertical)
+                    child->SetLayoutRect(FloatRect(padding, position, padding + breadth, position + length));
+                else
+                    child->SetLayoutRect(FloatRect(position, padding, position + length, padding + breadth));
+
+                position += length + GetSpacing();
+            }
+        }
+
+        HBox::HBox()
+            :   BoxLayout(BoxLayout::HORIZONTAL)
+        {
+            SetDefaultStyle("BI_HBox");
+            LoadStyle(GetInitialStyle());
+        }
+
+        VBox::VBox()
+            :   BoxLayout(BoxLayout::VERTICAL)
+        {
+            SetDefaultStyle("BI_VBox");
+            LoadStyle(GetInitialStyle());
+        }
+
+        Flex::Flex(Direction direction)
+            :   BoxLayout(direction),
+                mGrowFactors()
+        {
+            mStretch = true;
+
+            SetDefaultStyle("BI_Flex");
+            LoadStyle(GetInitialStyle());
+        }
+
+        float   Flex::GetGrow(const Widget* child) const
+        {
+            GrowFactors::const_iterator it = mGrowFactors.find(child);
+
+            return (it != mGrowFactors.end()) ? it->second : 0.f;
+        }
+
+        float   Flex::GetGrowFactor(const Widget& child) const
+        {
+            return GetGrow(&child);
+        }
+
+        void    Flex::OnChildRemoved(const Widget* child)
+        {
+            // The factors are keyed by address, a widget created later at the same address would inherit it
+            mGrowFactors.erase(child);
+        }
+
+        bool    Flex::IsStretched() const
+        {
+            return mStretch;
+        }
+
+        void    Flex::SetGrow(const Widget* child, float grow)
+        {
+            if (grow > 0.f)
+                mGrowFactors[child] = grow;
+            else
+                mGrowFactors.erase(child);
+
+            InvalidateMeasure();
+        }
+
+        void    Flex::SetStretch(bool stretch)
+        {
+            mStretch = stretch;
+            InvalidateMeasure();
+        }
+
+        Grid::Grid(unsigned int columns)
+            :   Layout(),
+                mColumnWidths(),
+                mColumns(std::max(columns, 1u)),
+                mRowHeights()
+        {
+            SetDefaultStyle("BI_Grid");
+            LoadStyle(GetInitialStyle());
+        }
+
+        unsigned int    Grid::GetColumnCount() const
+        {
+            return mColumns;
+        }
+
+        void    Grid::SetColumnCount(unsigned int columns)
+        {
+            mColumns = std::max(columns, 1u);
+            InvalidateMeasure();
+        }
+
+        void    Grid::LoadStyle(const std::string& nameStyle)
+        {
+            ResourceManager* rm = ResourceManager::Get();
+            StyleProperties& properties = rm->GetStyle(nameStyle);
+
+            SetColumnCount(rm->GetValue(properties["columns"], GetColumnCount()));
+
+            Layout::LoadStyle(nameStyle);
+        }
+
+        Vector2f    Grid::OnMeasure() const
+        {
+            unsigned int count = 0;
+
+            mColumnWidths.assign(mColumns, 0.f);
+            mRowHeights.clear();
+
+            for (Widget* child = GetFirstChild(); child; child = child->GetNextSibling())
+            {
+                if (!child->IsVisible())
+                    continue;
+
+                const Vector2f& size = child->GetMeasuredSize();
+                const unsigned int column = count % mColumns;
+
+                if (column == 0)
+                    mRowHeights.push_back(0.f);
+
+                mColumnWidths[column] = std::max(mColumnWidths[column], size.x);
+                mRowHeights.back() = std::max(mRowHeights.back(), size.y);
+                ++count;
+            }
+
+            const unsigned int columns = std::min(count, mColumns);
+            const unsigned int rows = static_cast<unsigned int>(mRowHeights.size());
+            Vector2f size(2.f * GetPadding(), 2.f * GetPadding());
+
+            for (unsigned int i = 0; i < columns; ++i)
+                size.x += mColumnWidths[i];
+            for (unsigned int i = 0; i < rows; ++i)
+                size.y += mRowHeights[i];
+
+            if (columns > 1)
+                size.x += GetSpacing() * (columns - 1);
+            if (rows > 1)
+                size.y += GetSpacing() * (rows - 1);
+
+            return size;
+        }
+
+        void    Grid::Arrange()
+        {
+            // The cell sizes are computed with the measure
+            GetMeasuredSize();
+
+            const float padding = GetPadding();
+            Vector2f cell(padding, padding);
+            unsigned int count = 0;
+
+            for (Widget* child = GetFirstChild(); child; child = child->GetNextSibling())
+            {
+                if (!child->IsVisible())
+                    continue;
+
+                const unsigned int column = count % mColumns;
+
+                if (column == 0 && count > 0)
+                {
+                    cell.x = padding;
+                    cell.y += mRowHeights[count / mColumns - 1] + GetSpacing();
+                }
+
+                const Vector2f& size = child->GetMeasuredSize();
+
+                child->SetLayoutRect(FloatRect(cell.x, cell.y, cell.x + size.x, cell.y + size.y));
+
+                cell.x += mColumnWidths[column] + GetSpacing();
+                ++count;
+            }
+        }
+
+    }
+
+}
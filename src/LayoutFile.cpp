@@ -0,0 +1,395 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#include <SFUI/CheckBox.hpp>
+#include <SFUI/DockSpace.hpp>
+#include <SFUI/Icon.hpp>
+#include <SFUI/Label.hpp>
+#include <SFUI/Layout.hpp>
+#include <SFUI/LayoutFile.hpp>
+#include <SFUI/RadioButton.hpp>
+#include <SFUI/Slider.hpp>
+#include <SFUI/TextButton.hpp>
+#include <SFUI/TextInput.hpp>
+#include <SFUI/WidgetPool.hpp>
+#include <SFUI/Window.hpp>
+
+#include <TinyXML/tinyxml.h>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** Binary layout file header, followed by the nodes and the string data */
+        struct _LayoutHeader
+        {
+            char    Magic[4];
+            Uint32  ByteOrder;
+            Uint32  Version;
+            Uint32  NodeCount;
+            Uint32  StringDataSize;
+        };
+
+        static const char   _LayoutMagic[4] = { 'S', 'F', 'L', 'Y' };
+        static const Uint32 _LayoutByteOrder = 0x01020304;
+        static const Uint32 _LayoutVersion = 1;
+
+
+        /** A registered widget type */
+        struct _WidgetType
+        {
+            LayoutFile::Factory Create;
+            std::size_t         Size;
+        };
+
+        typedef std::map<std::string, _WidgetType>  _WidgetTypes;
+
+        template <typename T>
+        static Widget*  _Create(const Unicode::Text&)
+        {
+            return new T();
+        }
+
+        template <typename T>
+        static Widget*  _CreateWithText(const Unicode::Text& text)
+        {
+            return new T(text);
+        }
+
+        static Widget*  _CreateHSlider(const Unicode::Text&)
+        {
+            return new Slider(Slider::HORIZONTAL);
+        }
+
+        static Widget*  _CreateVSlider(const Unicode::Text&)
+        {
+            return new Slider(Slider::VERTICAL);
+        }
+
+        static void     _AddType(_WidgetTypes& types, const std::string& type, LayoutFile::Factory factory, std::size_t size)
+        {
+            _WidgetType& widgetType = types[type];
+
+            widgetType.Create = factory;
+            widgetType.Size = size;
+        }
+
+        static _WidgetTypes&    _GetTypes()
+        {
+            static _WidgetTypes types;
+
+            if (types.empty())
+            {
+                _AddType(types, "CheckBox", &_CreateWithText<CheckBox>, sizeof(CheckBox));
+                _AddType(types, "DockSpace", &_Create<DockSpace>, sizeof(DockSpace));
+                _AddType(types, "Flex", &_Create<Flex>, sizeof(Flex));
+                _AddType(types, "Grid", &_Create<Grid>, sizeof(Grid));
+                _AddType(types, "HBox", &_Create<HBox>, sizeof(HBox));
+                _AddType(types, "HSlider", &_CreateHSlider, sizeof(Slider));
+                _AddType(types, "Icon", &_Create<Icon>, sizeof(Icon));
+                _AddType(types, "Label", &_CreateWithText<Label>, sizeof(Label));
+                _AddType(types, "RadioArea", &_Create<RadioArea>, sizeof(RadioArea));
+                _AddType(types, "RadioButton", &_CreateWithText<RadioButton>, sizeof(RadioButton));
+                _AddType(types, "TextButton", &_CreateWithText<TextButton>, sizeof(TextButton));
+                _AddType(types, "TextInput", &_CreateWithText<TextInput>, sizeof(TextInput));
+                _AddType(types, "VBox", &_Create<VBox>, sizeof(VBox));
+                _AddType(types, "VSlider", &_CreateVSlider, sizeof(Slider));
+                _AddType(types, "Widget", &_Create<Widget>, sizeof(Widget));
+                _AddType(types, "Window", &_CreateWithText<Window>, sizeof(Window));
+            }
+
+            return types;
+        }
+
+        /** Store a string once in the string data */
+        static Uint32   _AddString(std::vector<char>& data, std::map<std::string, Uint32>& offsets, const char* str)
+        {
+            if (!str || !*str)
+                return 0;
+
+            std::map<std::string, Uint32>::iterator it = offsets.find(str);
+
+            if (it != offsets.end())
+                return it->second;
+
+            const Uint32 offset = static_cast<Uint32>(data.size());
+
+            data.insert(data.end(), str, str + std::strlen(str) + 1);
+            offsets[str] = offset;
+
+            return offset;
+        }
+
+        /** Add the nodes of an element and its children, parents first */
+        static void     _ReadElement(const TiXmlElement* element, Uint32 parent, std::vector<LayoutFile::Node>& nodes,
+                                     std::vector<char>& data, std::map<std::string, Uint32>& offsets)
+        {
+            for (; element; element = element->NextSiblingElement())
+            {
+                LayoutFile::Node node;
+
+                node.Type = _AddString(data, offsets, element->Value());
+                node.Name = _AddString(data, offsets, element->Attribute("name"));
+                node.Style = _AddString(data, offsets, element->Attribute("style"));
+                node.Text = _AddString(data, offsets, element->Attribute("text"));
+                node.Parent = parent;
+
+                nodes.push_back(node);
+
+                _ReadElement(element->FirstChildElement(), static_cast<Uint32>(nodes.size() - 1), nodes, data, offsets);
+            }
+        }
+
+        template <typename T>
+        static void     _Write(std::ofstream& file, const T& value)
+        {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+
+        LayoutFile::LayoutFile()
+            :   mNodes(),
+                mStrings(1, '\0')
+        {
+
+        }
+
+        bool    LayoutFile::LoadFromFile(const std::string& filename)
+        {
+            TiXmlDocument document(filename.c_str());
+
+            if (!document.LoadFile())
+            {
+                std::cerr << "Could not load \"" << filename << "\" layout file (" << document.ErrorDesc() << ")" << std::endl;
+                return false;
+            }
+
+            const TiXmlElement* root = document.RootElement();
+
+            if (!root || std::string(root->Value()) != "layout")
+            {
+                std::cerr << "\"" << filename << "\" is not a layout file (no <layout> root)" << std::endl;
+                return false;
+            }
+
+            std::vector<Node> nodes;
+            std::vector<char> strings(1, '\0');
+            std::map<std::string, Uint32> offsets;
+
+            _ReadElement(root->FirstChildElement(), NoIndex, nodes, strings, offsets);
+
+            mNodes.swap(nodes);
+            mStrings.swap(strings);
+            return true;
+        }
+
+        bool    LayoutFile::SaveToBinary(const std::string& filename) const
+        {
+            std::ofstream out(filename.c_str(), std::ios::binary);
+
+            if (!out)
+            {
+                std::cerr << "Could not write \"" << filename << "\" layout file" << std::endl;
+                return false;
+            }
+
+            _LayoutHeader header;
+
+            std::memcpy(header.Magic, _LayoutMagic, sizeof(header.Magic));
+            header.ByteOrder = _LayoutByteOrder;
+            header.Version = _LayoutVersion;
+            header.NodeCount = static_cast<Uint32>(mNodes.size());
+            header.StringDataSize = static_cast<Uint32>(mStrings.size());
+
+            _Write(out, header);
+
+            for (std::vector<Node>::const_iterator it = mNodes.begin(); it != mNodes.end(); ++it)
+                _Write(out, *it);
+
+            out.write(&mStrings[0], mStrings.size());
+
+            return out.good();
+        }
+
+        bool    LayoutFile::LoadFromBinary(const std::string& filename)
+        {
+            std::ifstream file(filename.c_str(), std::ios::binary);
+            _LayoutHeader header;
+
+            if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+                std::memcmp(header.Magic, _LayoutMagic, sizeof(_LayoutMagic)) != 0 ||
+                header.ByteOrder != _LayoutByteOrder || header.Version != _LayoutVersion || header.StringDataSize == 0)
+            {
+                std::cerr << "\"" << filename << "\" is not a valid layout file" << std::endl;
+                return false;
+            }
+
+            const std::streamoff start = file.tellg();
+
+            file.seekg(0, std::ios::end);
+            const std::streamoff remaining = file.tellg() - start;
+            file.seekg(start, std::ios::beg);
+
+            if (remaining != static_cast<std::streamoff>(header.NodeCount * sizeof(Node) + header.StringDataSize))
+            {
+                std::cerr << "\"" << filename << "\" layout file is truncated" << std::endl;
+                return false;
+            }
+
+            // The records are read as they are, then checked before being used
+            std::vector<Node> nodes(header.NodeCount);
+            std::vector<char> strings(header.StringDataSize);
+
+            if ((header.NodeCount > 0 && !file.read(reinterpret_cast<char*>(&nodes[0]), header.NodeCount * sizeof(Node))) ||
+                !file.read(&strings[0], header.StringDataSize))
+            {
+                std::cerr << "\"" << filename << "\" layout file is truncated" << std::endl;
+                return false;
+            }
+
+            bool valid = (strings.back() == '\0');
+
+            for (Uint32 i = 0; valid && i < header.NodeCount; ++i)
+            {
+                const Node& node = nodes[i];
+
+                valid = (node.Type < header.StringDataSize && node.Name < header.StringDataSize &&
+                         node.Style < header.StringDataSize && node.Text < header.StringDataSize &&
+                         (node.Parent == NoIndex || node.Parent < i));
+            }
+
+            if (!valid)
+            {
+                std::cerr << "\"" << filename << "\" layout file is corrupted" << std::endl;
+                return false;
+            }
+
+            mNodes.swap(nodes);
+            mStrings.swap(strings);
+            return true;
+        }
+
+        bool    LayoutFile::Build(Widget& parent, Widgets& widgets) const
+        {
+            const _WidgetTypes& types = _GetTypes();
+            std::vector<const _WidgetType*> nodeTypes(mNodes.size());
+            std::map<std::size_t, unsigned int> sizeCounts;
+
+            for (std::size_t i = 0; i < mNodes.size(); ++i)
+            {
+                _WidgetTypes::const_iterator it = types.find(GetString(mNodes[i].Type));
+
+                if (it == types.end())
+                {
+                    std::cerr << "Unknown widget type \"" << GetString(mNodes[i].Type) << "\" in layout" << std::endl;
+                    return false;
+                }
+
+                nodeTypes[i] = &it->second;
+
+                if (it->second.Size > 0)
+                    ++sizeCounts[WidgetPool::GetSlotSize(it->second.Size)];
+            }
+
+            // Widgets of the same size class are allocated one after the other, whatever their type
+            for (std::map<std::size_t, unsigned int>::const_iterator it = sizeCounts.begin(); it != sizeCounts.end(); ++it)
+                WidgetPool::Reserve(it->first, it->second);
+
+            widgets.clear();
+            widgets.reserve(mNodes.size());
+
+            for (std::size_t i = 0; i < mNodes.size(); ++i)
+            {
+                const Node& node = mNodes[i];
+                const char* style = GetString(node.Style);
+
+                // The constructor loads the style of the node instead of its default style
+                Widget::SetInitialStyle(style);
+                Widget* widget = nodeTypes[i]->Create(std::string(GetString(node.Text)));
+                Widget::SetInitialStyle("");
+
+                // Registered types may not load their style in the constructor
+                if (*style && widget->GetCurrentStyle() != style)
+                    widget->LoadStyle(style);
+
+                Widget* owner = (node.Parent == NoIndex) ? &parent : widgets[node.Parent];
+                RadioArea* area = dynamic_cast<RadioArea*>(owner);
+                DockSpace* dockSpace = dynamic_cast<DockSpace*>(owner);
+
+                if (area && dynamic_cast<RadioButton*>(widget))
+                    area->AddRadioButton(static_cast<RadioButton*>(widget));
+                else if (dockSpace && dynamic_cast<Window*>(widget))
+                    dockSpace->Dock(static_cast<Window*>(widget));
+                else
+                    owner->Add(widget);
+
+                widgets.push_back(widget);
+            }
+
+            return true;
+        }
+
+        Uint32  LayoutFile::FindNode(const std::string& name) const
+        {
+            for (std::size_t i = 0; i < mNodes.size(); ++i)
+            {
+                if (name == GetString(mNodes[i].Name))
+                    return static_cast<Uint32>(i);
+            }
+
+            return NoIndex;
+        }
+
+        const LayoutFile::Node&     LayoutFile::GetNode(Uint32 index) const
+        {
+            return mNodes[index];
+        }
+
+        Uint32  LayoutFile::GetNodeCount() const
+        {
+            return static_cast<Uint32>(mNodes.size());
+        }
+
+        const char*     LayoutFile::GetString(Uint32 offset) const
+        {
+            return &mStrings[offset];
+        }
+
+        void    LayoutFile::RegisterType(const std::string& type, Factory factory, std::size_t size)
+        {
+            _AddType(_GetTypes(), type, factory, size);
+        }
+
+    }
+
+}
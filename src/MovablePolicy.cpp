@@ -39,10 +39,18 @@ namespace sf
                 mMovableY(true),
                 mBlocked(false),
                 mDragged(false),
-                mDragOffset(0.f, 0.f),
-                mNeedUpdate(false)
+                mDragLimits(0.f, 0.f, 0.f, 0.f),
+                mDragPosition(0.f, 0.f),
+                mDragStart(0.f, 0.f),
+                mGhost(),
+                mGhostDrag(false),
+                mGhostOrigin(0.f, 0.f),
+                mMoved(false),
+                mStartPosition(0.f, 0.f)
         {
-
+            mGhost.SetColor(Color(0, 0, 0, 0));
+            mGhost.SetBorderColor(Color(255, 255, 255, 192));
+            mGhost.SetFocusable(false);
         }
 
         void    MovablePolicy::SetMovable(bool movable)
@@ -65,6 +73,26 @@ namespace sf
             mBlocked = blocked;
         }
 
+        void    MovablePolicy::SetGhostColor(const Color& color)
+        {
+            mGhost.SetBorderColor(color);
+        }
+
+        void    MovablePolicy::SetGhostDrag(bool ghostDrag)
+        {
+            mGhostDrag = ghostDrag;
+        }
+
+        const Color&    MovablePolicy::GetGhostColor() const
+        {
+            return mGhost.GetBorderColor();
+        }
+
+        bool    MovablePolicy::IsGhostDrag() const
+        {
+            return mGhostDrag;
+        }
+
         bool    MovablePolicy::IsMovable() const
         {
             return (mMovableX || mMovableY);
@@ -94,6 +122,8 @@ namespace sf
             SetMovableX(rm->GetValue(properties["movableX"], IsMovableX()));
             SetMovableY(rm->GetValue(properties["movableY"], IsMovableY()));
             SetBlocked(rm->GetValue(properties["blocked"], IsBlocked()));
+            SetGhostDrag(rm->GetValue(properties["ghostDrag"], IsGhostDrag()));
+            SetGhostColor(rm->GetColorValue(properties["ghostColor"], GetGhostColor()));
         }
 
         void    MovablePolicy::OnMousePressed(const Event::MouseButtonEvent& button)
@@ -102,55 +132,103 @@ namespace sf
                 return;
 
             mDragged = true;
-            mNeedUpdate = true;
+            mMoved = false;
+            mDragStart = Vector2f(button.X, button.Y);
+            mStartPosition = mDragPosition = mWidget.GetPosition();
+
+            Widget* parent = mWidget.GetParent();
+
+            // Positions allowed by the parent boundaries, in the parent coordinates
+            if (parent)
+                mDragLimits = FloatRect(0.f, 0.f, parent->GetWidth() - mWidget.GetWidth(), parent->GetHeight() - mWidget.GetHeight());
 
             mWidget.ChangeZIndex(Widget::ALL_ABOVE);
+
+            if (mGhostDrag && parent)
+            {
+                Widget* root = parent;
+
+                while (root->GetParent())
+                    root = root->GetParent();
+
+                // The ghost is drawn above everything, in the root coordinates
+                mGhostOrigin = mWidget.GetAbsolutePosition() - mStartPosition - root->GetPosition();
+                mGhost.SetSize(mWidget.GetSize());
+                mGhost.SetPosition(mGhostOrigin + mStartPosition);
+                root->Add(&mGhost);
+            }
         }
 
         void    MovablePolicy::OnMouseReleased(const Event::MouseButtonEvent& button)
         {
-            mDragged = false;
+            Drop();
         }
 
         void    MovablePolicy::OnMouseMoved(const Event::MouseMoveEvent& mouse)
         {
-            if (mDragged && IsMovable())
+            if (!mDragged || !IsMovable())
+                return;
+
+            Vector2f newPos = mStartPosition + Vector2f(mouse.X, mouse.Y) - mDragStart;
+
+            if (mBlocked && mWidget.GetParent())
             {
-                const Vector2f& mousePos = Vector2f(mouse.X, mouse.Y);
-                const Vector2f& absPos = mWidget.GetAbsolutePosition();
+                if (newPos.x < mDragLimits.Left)
+                    newPos.x = mDragLimits.Left;
+                else if (newPos.x > mDragLimits.Right)
+                    newPos.x = mDragLimits.Right;
+
+                if (newPos.y < mDragLimits.Top)
+                    newPos.y = mDragLimits.Top;
+                else if (newPos.y > mDragLimits.Bottom)
+                    newPos.y = mDragLimits.Bottom;
+            }
 
-                if (mNeedUpdate)
-                {
-                    mNeedUpdate = false;
-                    mDragOffset = mousePos - absPos;
-                }
+            if (!mMovableX)
+                newPos.x = mStartPosition.x;
 
-                Vector2f newPos = mousePos - mDragOffset;
-                Widget* parent = mWidget.GetParent();
+            if (!mMovableY)
+                newPos.y = mStartPosition.y;
 
-                if (parent && mBlocked)
-                {
-                    const Vector2f& limitPos = absPos - mWidget.GetPosition();
+            if (newPos.x == mDragPosition.x && newPos.y == mDragPosition.y)
+                return;
 
-                    if (newPos.x < limitPos.x)
-                        newPos.x = limitPos.x;
-                    else if (newPos.x + mWidget.GetWidth() > limitPos.x + parent->GetWidth())
-                        newPos.x = limitPos.x + parent->GetWidth() - mWidget.GetWidth();
+            mDragPosition = newPos;
 
-                    if (newPos.y < limitPos.y)
-                        newPos.y = limitPos.y;
-                    else if (newPos.y + mWidget.GetHeight() > limitPos.y + parent->GetHeight())
-                        newPos.y = limitPos.y + parent->GetHeight() - mWidget.GetHeight();
-                }
+            // Only the position changes, no signal is sent during the drag
+            if (mGhost.GetParent())
+            {
+                mGhost.SetPosition(mGhostOrigin + newPos);
+            }
+            else
+            {
+                // The widget leaves its alignment when it really moves : a parent resize must not align it back
+                if (!mMoved)
+                    mWidget.SetAlignment(Align::NONE);
 
-                if (!mMovableX)
-                    newPos.x = absPos.x;
+                mWidget.SetPosition(newPos);
+            }
+
+            mMoved = true;
+        }
 
-                if (!mMovableY)
-                    newPos.y = absPos.y;
+        void    MovablePolicy::Drop()
+        {
+            if (!mDragged)
+                return;
 
-                mWidget.Move(newPos - absPos);
-                mWidget.SetAlignment(Align::NONE);
+            mDragged = false;
+
+            if (mGhost.GetParent())
+            {
+                mGhost.GetParent()->Remove(&mGhost);
+
+                // The widget only leaves its alignment once the ghost is dropped
+                if (mMoved)
+                {
+                    mWidget.SetPosition(mDragPosition);
+                    mWidget.SetAlignment(Align::NONE);
+                }
             }
         }
     }
@@ -0,0 +1,193 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderQueue.hpp>
+
+#include <SFUI/NineSlice.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        static bool     _IsEmpty(const FloatRect& rect)
+        {
+            return (rect.Right <= rect.Left || rect.Bottom <= rect.Top);
+        }
+
+        NineSlice::NineSlice()
+            :   Drawable(),
+                mGrid(false),
+                mGridChecked(false),
+                mImage(0)
+        {
+
+        }
+
+        const FloatRect&    NineSlice::GetDestRect(unsigned int column, unsigned int row) const
+        {
+            return mDestRects[row * 3 + column];
+        }
+
+        const Image*    NineSlice::GetImage() const
+        {
+            return mImage;
+        }
+
+        const IntRect&  NineSlice::GetSourceRect(unsigned int column, unsigned int row) const
+        {
+            return mSourceRects[row * 3 + column];
+        }
+
+        void    NineSlice::SetImage(const Image* image)
+        {
+            mImage = image;
+        }
+
+        void    NineSlice::SetPart(unsigned int column, unsigned int row, const IntRect& source, const FloatRect& dest)
+        {
+            mSourceRects[row * 3 + column] = source;
+            mDestRects[row * 3 + column] = dest;
+            mGridChecked = false;
+        }
+
+        void    NineSlice::GetGridLines(float* xs, float* ys, int* us, int* vs) const
+        {
+            // The grid lines are given by the top left and bottom right parts
+            const FloatRect& first = mDestRects[0];
+            const FloatRect& last = mDestRects[8];
+            const IntRect& firstSource = mSourceRects[0];
+            const IntRect& lastSource = mSourceRects[8];
+
+            xs[0] = first.Left;         xs[1] = first.Right;        xs[2] = last.Left;          xs[3] = last.Right;
+            ys[0] = first.Top;          ys[1] = first.Bottom;       ys[2] = last.Top;           ys[3] = last.Bottom;
+            us[0] = firstSource.Left;   us[1] = firstSource.Right;  us[2] = lastSource.Left;    us[3] = lastSource.Right;
+            vs[0] = firstSource.Top;    vs[1] = firstSource.Bottom; vs[2] = lastSource.Top;     vs[3] = lastSource.Bottom;
+        }
+
+        bool    NineSlice::IsGrid() const
+        {
+            if (mGridChecked)
+                return mGrid;
+
+            float xs[4], ys[4];
+            int us[4], vs[4];
+
+            GetGridLines(xs, ys, us, vs);
+
+            mGridChecked = true;
+            mGrid = false;
+
+            for (unsigned int row = 0; row < 3; ++row)
+            {
+                for (unsigned int column = 0; column < 3; ++column)
+                {
+                    const FloatRect& dest = mDestRects[row * 3 + column];
+                    const IntRect& source = mSourceRects[row * 3 + column];
+
+                    if (dest.Left != xs[column] || dest.Right != xs[column + 1] || dest.Top != ys[row] || dest.Bottom != ys[row + 1])
+                        return false;
+
+                    if (source.Left != us[column] || source.Right != us[column + 1] || source.Top != vs[row] || source.Bottom != vs[row + 1])
+                        return false;
+                }
+            }
+
+            mGrid = true;
+            return true;
+        }
+
+        void    NineSlice::Render(RenderTarget&, RenderQueue& queue) const
+        {
+            if (!mImage)
+                return;
+
+            queue.SetTexture(mImage);
+            queue.BeginBatch();
+
+            if (IsGrid())
+            {
+                float xs[4], ys[4];
+                int us[4], vs[4];
+
+                GetGridLines(xs, ys, us, vs);
+
+                const FloatRect first = mImage->GetTexCoords(IntRect(us[0], vs[0], us[1], vs[1]));
+                const FloatRect last = mImage->GetTexCoords(IntRect(us[2], vs[2], us[3], vs[3]));
+                const float coordsX[4] = { first.Left, first.Right, last.Left, last.Right };
+                const float coordsY[4] = { first.Top, first.Bottom, last.Top, last.Bottom };
+
+                // 4x4 vertices shared by the neighbour parts
+                for (unsigned int row = 0; row < 4; ++row)
+                {
+                    for (unsigned int column = 0; column < 4; ++column)
+                        queue.AddVertex(xs[column], ys[row], coordsX[column], coordsY[row]);
+                }
+
+                for (unsigned int row = 0; row < 3; ++row)
+                {
+                    for (unsigned int column = 0; column < 3; ++column)
+                    {
+                        const unsigned int i = row * 4 + column;
+
+                        if (_IsEmpty(mDestRects[row * 3 + column]))
+                            continue;
+
+                        queue.AddTriangle(i, i + 1, i + 5);
+                        queue.AddTriangle(i, i + 5, i + 4);
+                    }
+                }
+            }
+            else
+            {
+                unsigned int vertices = 0;
+
+                for (unsigned int i = 0; i < 9; ++i)
+                {
+                    const FloatRect& dest = mDestRects[i];
+
+                    if (_IsEmpty(dest))
+                        continue;
+
+                    const FloatRect coords = mImage->GetTexCoords(mSourceRects[i]);
+
+                    queue.AddVertex(dest.Left, dest.Top, coords.Left, coords.Top);
+                    queue.AddVertex(dest.Right, dest.Top, coords.Right, coords.Top);
+                    queue.AddVertex(dest.Right, dest.Bottom, coords.Right, coords.Bottom);
+                    queue.AddVertex(dest.Left, dest.Bottom, coords.Left, coords.Bottom);
+
+                    queue.AddTriangle(vertices, vertices + 1, vertices + 2);
+                    queue.AddTriangle(vertices, vertices + 2, vertices + 3);
+                    vertices += 4;
+                }
+            }
+        }
+
+    }
+
+}
@@ -0,0 +1,337 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__GNUC__)
+    #include <cxxabi.h>
+#endif
+
+#include <SFML/System/Clock.hpp>
+
+#include <SFUI/Profiler.hpp>
+#include <SFUI/Widget.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        const unsigned int  Profiler::HistorySize;
+
+        bool    Profiler::mEnabled = false;
+
+        bool    Profiler::mWidgetsRecorded = false;
+
+        /** Section being measured */
+        struct _OpenSection
+        {
+            Clock               Timer;
+            Profiler::Section   Type;
+            const Widget*       Owner;
+            float               ChildTime;
+        };
+
+        /** Recorded data of the profiler */
+        struct _ProfilerData
+        {
+            _ProfilerData()
+                :   FrameIndex(0),
+                    FrameCount(0)
+            {
+                Clear(Current);
+            }
+
+            static void Clear(Profiler::Frame& frame)
+            {
+                frame.Time = 0.f;
+
+                for (unsigned int i = 0; i < Profiler::SECTION_COUNT; ++i)
+                    frame.Sections[i] = 0.f;
+                for (unsigned int i = 0; i < Profiler::COUNTER_COUNT; ++i)
+                    frame.Counters[i] = 0;
+            }
+
+            Profiler::Frame             Frames[Profiler::HistorySize];
+
+            unsigned int                FrameIndex;
+
+            unsigned int                FrameCount;
+
+            Profiler::Frame             Current;
+
+            Clock                       FrameClock;
+
+            std::vector<_OpenSection>   Stack;
+
+            Profiler::TypeEntries       Types;
+
+            Profiler::WidgetEntries     Widgets;
+
+            std::map<const char*, std::string>  TypeNames;
+        };
+
+        static _ProfilerData&   _GetData()
+        {
+            // Never destroyed : widgets with static storage may be destroyed after it
+            static _ProfilerData* data = new _ProfilerData;
+
+            return *data;
+        }
+
+        /** Readable class name of a widget, demangled once per type */
+        static const std::string&   _GetTypeName(const Widget& widget)
+        {
+            const char* mangled = typeid(widget).name();
+            std::map<const char*, std::string>& names = _GetData().TypeNames;
+            std::map<const char*, std::string>::iterator it = names.find(mangled);
+
+            if (it != names.end())
+                return it->second;
+
+            std::string& name = names[mangled];
+            name = mangled;
+
+#if defined(__GNUC__)
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(mangled, 0, 0, &status);
+
+            if (demangled && status == 0)
+                name = demangled;
+            std::free(demangled);
+#endif
+
+            return name;
+        }
+
+        static void     _WriteJsonString(std::ostream& stream, const std::string& str)
+        {
+            stream << '"';
+
+            for (std::string::const_iterator it = str.begin(); it != str.end(); ++it)
+            {
+                if (*it == '"' || *it == '\\')
+                    stream << '\\';
+                stream << *it;
+            }
+            stream << '"';
+        }
+
+        void    Profiler::Enable(bool enable)
+        {
+            if (enable && !mEnabled)
+                _GetData().FrameClock.Reset();
+
+            mEnabled = enable;
+        }
+
+        void    Profiler::Begin(Section section, const Widget* widget)
+        {
+            _ProfilerData& data = _GetData();
+
+            data.Stack.push_back(_OpenSection());
+
+            _OpenSection& open = data.Stack.back();
+
+            open.Type = section;
+            open.Owner = widget;
+            open.ChildTime = 0.f;
+            open.Timer.Reset();
+        }
+
+        void    Profiler::End()
+        {
+            _ProfilerData& data = _GetData();
+
+            if (data.Stack.empty())
+                return;
+
+            const _OpenSection& open = data.Stack.back();
+            const float time = open.Timer.GetElapsedTime();
+            const float self = (time > open.ChildTime) ? time - open.ChildTime : 0.f;
+
+            data.Current.Sections[open.Type] += self;
+
+            if (open.Owner)
+            {
+                Entry& widgetEntry = data.Widgets[open.Owner];
+                Entry& typeEntry = data.Types[_GetTypeName(*open.Owner)];
+
+                widgetEntry.Time += self;
+                ++widgetEntry.Calls;
+                typeEntry.Time += self;
+                ++typeEntry.Calls;
+                mWidgetsRecorded = true;
+            }
+
+            data.Stack.pop_back();
+
+            if (!data.Stack.empty())
+                data.Stack.back().ChildTime += time;
+        }
+
+        void    Profiler::AddToCounter(Counter counter, unsigned int value)
+        {
+            _GetData().Current.Counters[counter] += value;
+        }
+
+        void    Profiler::EndFrame()
+        {
+            if (!mEnabled)
+                return;
+
+            _ProfilerData& data = _GetData();
+
+            data.Current.Time = data.FrameClock.GetElapsedTime();
+            data.FrameClock.Reset();
+
+            data.Frames[data.FrameIndex] = data.Current;
+            data.FrameIndex = (data.FrameIndex + 1) % HistorySize;
+            if (data.FrameCount < HistorySize)
+                ++data.FrameCount;
+
+            _ProfilerData::Clear(data.Current);
+        }
+
+        void    Profiler::ForgetWidget(const Widget* widget)
+        {
+            _GetData().Widgets.erase(widget);
+        }
+
+        const Profiler::Frame&  Profiler::GetFrame(unsigned int age)
+        {
+            const _ProfilerData& data = _GetData();
+
+            return data.Frames[(data.FrameIndex + HistorySize - 1 - age % HistorySize) % HistorySize];
+        }
+
+        unsigned int    Profiler::GetFrameCount()
+        {
+            return _GetData().FrameCount;
+        }
+
+        const char*     Profiler::GetSectionName(Section section)
+        {
+            static const char* names[SECTION_COUNT] = { "display", "injectEvent", "render", "paint", "loadStyle", "layout" };
+
+            return names[section];
+        }
+
+        const char*     Profiler::GetCounterName(Counter counter)
+        {
+            static const char* names[COUNTER_COUNT] = { "drawCalls", "scissorFlushes", "styleReloads", "fontLoads" };
+
+            return names[counter];
+        }
+
+        const Profiler::TypeEntries&    Profiler::GetTypeEntries()
+        {
+            return _GetData().Types;
+        }
+
+        const Profiler::WidgetEntries&  Profiler::GetWidgetEntries()
+        {
+            return _GetData().Widgets;
+        }
+
+        void    Profiler::Reset()
+        {
+            _ProfilerData& data = _GetData();
+
+            data.FrameIndex = data.FrameCount = 0;
+            data.Types.clear();
+            data.Widgets.clear();
+            data.FrameClock.Reset();
+            mWidgetsRecorded = false;
+            _ProfilerData::Clear(data.Current);
+        }
+
+        void    Profiler::WriteJson(std::ostream& stream)
+        {
+            const _ProfilerData& data = _GetData();
+
+            stream << "{\n  \"frames\": [";
+
+            // Oldest frames first
+            for (unsigned int i = data.FrameCount; i > 0; --i)
+            {
+                const Frame& frame = GetFrame(i - 1);
+
+                stream << ((i == data.FrameCount) ? "\n" : ",\n") << "    { \"time\": " << frame.Time;
+
+                for (unsigned int s = 0; s < SECTION_COUNT; ++s)
+                    stream << ", \"" << GetSectionName(static_cast<Section>(s)) << "\": " << frame.Sections[s];
+                for (unsigned int c = 0; c < COUNTER_COUNT; ++c)
+                    stream << ", \"" << GetCounterName(static_cast<Counter>(c)) << "\": " << frame.Counters[c];
+
+                stream << " }";
+            }
+
+            stream << "\n  ],\n  \"types\": {";
+
+            for (TypeEntries::const_iterator it = data.Types.begin(); it != data.Types.end(); ++it)
+            {
+                stream << ((it == data.Types.begin()) ? "\n    " : ",\n    ");
+                _WriteJsonString(stream, it->first);
+                stream << ": { \"time\": " << it->second.Time << ", \"calls\": " << it->second.Calls << " }";
+            }
+
+            stream << "\n  },\n  \"widgets\": [";
+
+            for (WidgetEntries::const_iterator it = data.Widgets.begin(); it != data.Widgets.end(); ++it)
+            {
+                stream << ((it == data.Widgets.begin()) ? "\n    " : ",\n    ") << "{ \"id\": \"" << it->first << "\", \"type\": ";
+                _WriteJsonString(stream, _GetTypeName(*it->first));
+                stream << ", \"style\": ";
+                _WriteJsonString(stream, it->first->GetCurrentStyle());
+                stream << ", \"time\": " << it->second.Time << ", \"calls\": " << it->second.Calls << " }";
+            }
+
+            stream << "\n  ]\n}\n";
+        }
+
+        bool    Profiler::ExportJson(const std::string& filename)
+        {
+            std::ofstream file(filename.c_str());
+
+            if (!file)
+            {
+                std::cerr << "Could not write \"" << filename << "\" profiler file" << std::endl;
+                return false;
+            }
+
+            WriteJson(file);
+            return true;
+        }
+
+    }
+
+}
@@ -0,0 +1,162 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <SFUI/Painter.hpp>
+#include <SFUI/Profiler.hpp>
+#include <SFUI/ProfilerOverlay.hpp>
+#include <SFUI/ResourceManager.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        typedef std::pair<float, std::string>   _TypeCost;
+
+        ProfilerOverlay::ProfilerOverlay()
+            :   Widget(Vector2f(0.f, 0.f), Vector2f(280.f, 180.f)),
+                mAveragedFrames(30),
+                mShownTypes(5),
+                mText("", Font::GetDefaultFont(), 12.f)
+        {
+            SetColor(Color(0, 0, 0, 160));
+            SetFocusable(false);
+            mText.SetColor(Color(255, 255, 255));
+
+            SetDefaultStyle("BI_ProfilerOverlay");
+            LoadStyle(GetInitialStyle());
+        }
+
+        void    ProfilerOverlay::SetAveragedFrames(unsigned int frames)
+        {
+            mAveragedFrames = std::max(1u, std::min(frames, Profiler::HistorySize));
+        }
+
+        unsigned int    ProfilerOverlay::GetAveragedFrames() const
+        {
+            return mAveragedFrames;
+        }
+
+        void    ProfilerOverlay::SetShownTypes(unsigned int count)
+        {
+            mShownTypes = count;
+        }
+
+        void    ProfilerOverlay::LoadStyle(const std::string& nameStyle)
+        {
+            ResourceManager* rm = ResourceManager::Get();
+            StyleProperties& properties = rm->GetStyle(nameStyle);
+
+            mText.SetColor(rm->GetColorValue(properties["textColor"], mText.GetColor()));
+            // The font is requested at the style text size, or at the size of its alias
+            const float textSize = rm->GetValue(properties["textSize"], 0.f);
+
+            if (textSize > 0.f)
+                mText.SetSize(textSize);
+
+            Font* newFont = rm->GetFont(properties["font"], textSize);
+            if (newFont)
+                mText.SetFont(*newFont);
+
+            Widget::LoadStyle(nameStyle);
+        }
+
+        void    ProfilerOverlay::OnPaint(Painter& painter) const
+        {
+            Widget::OnPaint(painter);
+
+            const unsigned int frames = std::min(mAveragedFrames, Profiler::GetFrameCount());
+            std::ostringstream text;
+
+            text.setf(std::ios::fixed);
+            text.precision(2);
+
+            if (frames == 0)
+            {
+                text << (Profiler::IsEnabled() ? "Waiting for frames" : "Profiler disabled");
+            }
+            else
+            {
+                float time = 0.f;
+                float sections[Profiler::SECTION_COUNT] = { 0.f };
+
+                for (unsigned int i = 0; i < frames; ++i)
+                {
+                    const Profiler::Frame& frame = Profiler::GetFrame(i);
+
+                    time += frame.Time;
+                    for (unsigned int s = 0; s < Profiler::SECTION_COUNT; ++s)
+                        sections[s] += frame.Sections[s];
+                }
+
+                text << "frame " << time * 1000.f / frames << " ms";
+                if (time > 0.f)
+                    text << " (" << frames / time << " fps)";
+                text << "\n";
+
+                for (unsigned int s = 0; s < Profiler::SECTION_COUNT; ++s)
+                {
+                    text << Profiler::GetSectionName(static_cast<Profiler::Section>(s)) << " "
+                         << sections[s] * 1000.f / frames << " ms" << ((s % 2) ? "\n" : "   ");
+                }
+
+                const Profiler::Frame& last = Profiler::GetFrame();
+
+                for (unsigned int c = 0; c < Profiler::COUNTER_COUNT; ++c)
+                    text << Profiler::GetCounterName(static_cast<Profiler::Counter>(c)) << " " << last.Counters[c] << "   ";
+                text << "\n";
+
+                // Most expensive widget types since the last reset
+                const Profiler::TypeEntries& types = Profiler::GetTypeEntries();
+                std::vector<_TypeCost> costs;
+                float total = 0.f;
+
+                for (Profiler::TypeEntries::const_iterator it = types.begin(); it != types.end(); ++it)
+                {
+                    costs.push_back(_TypeCost(it->second.Time, it->first));
+                    total += it->second.Time;
+                }
+
+                std::sort(costs.rbegin(), costs.rend());
+
+                for (unsigned int i = 0; i < costs.size() && i < mShownTypes && total > 0.f; ++i)
+                    text << costs[i].second << " " << costs[i].first * 100.f / total << " %\n";
+            }
+
+            mText.SetText(text.str());
+
+            painter.DrawString(mText);
+        }
+
+    }
+
+}
@@ -38,7 +38,7 @@ namespace sf
             :   CheckBox(caption)
         {
             SetDefaultStyle("BI_RadioButton");
-            LoadStyle(GetDefaultStyle());
+            LoadStyle(GetInitialStyle());
         }
 
         RadioArea::RadioArea()
@@ -47,7 +47,7 @@ namespace sf
                 mSelectedRadio(0)
         {
             SetDefaultStyle("BI_RadioArea");
-            LoadStyle(GetDefaultStyle());
+            LoadStyle(GetInitialStyle());
 
             Add(&mDecorator);
         }
@@ -0,0 +1,542 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include <SFUI/RasterKernels.hpp>
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__)) && (__GNUC__ * 100 + __GNUC_MINOR__ >= 409 || defined(__clang__))
+    #define SFUI_RASTER_X86
+    #define SFUI_RASTER_TARGET(x)   __attribute__((target(x)))
+    #include <immintrin.h>
+#elif defined(_MSC_VER) && _MSC_VER >= 1700 && (defined(_M_IX86) || defined(_M_X64))
+    #define SFUI_RASTER_X86
+    #define SFUI_RASTER_TARGET(x)
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
+
+namespace sf
+{
+    namespace ui
+    {
+        namespace Raster
+        {
+            /** Rounded division by 255, exact for x <= 255 * 255 */
+            static inline unsigned int  _Div255(unsigned int x)
+            {
+                x += 128;
+                return (x + (x >> 8)) >> 8;
+            }
+
+            /** Source over of one premultiplied pixel, saturated like the vectorized versions */
+            static inline void  _BlendPixel(Uint8* dst, const Uint8* src)
+            {
+                const unsigned int inverse = 255 - src[3];
+
+                for (unsigned int c = 0; c < 4; ++c)
+                    dst[c] = static_cast<Uint8>(std::min(255u, src[c] + _Div255(dst[c] * inverse)));
+            }
+
+            /** Multiply the 4 channels of a pixel by 4 factors */
+            static inline void  _Modulate(Uint8* dst, const Uint8* src, const Uint8* factors)
+            {
+                for (unsigned int c = 0; c < 4; ++c)
+                    dst[c] = static_cast<Uint8>(_Div255(src[c] * factors[c]));
+            }
+
+            static void _FillSpanScalar(Uint32* dst, unsigned int count, Uint32 color)
+            {
+                std::fill(dst, dst + count, color);
+            }
+
+            static void _BlendSpanScalar(Uint32* dst, unsigned int count, Uint32 color)
+            {
+                const Uint8* src = reinterpret_cast<const Uint8*>(&color);
+
+                for (unsigned int i = 0; i < count; ++i)
+                    _BlendPixel(reinterpret_cast<Uint8*>(dst + i), src);
+            }
+
+            static void _BlendPixelsScalar(Uint32* dst, const Uint32* src, unsigned int count, Uint32 modulate)
+            {
+                const Uint8* factors = reinterpret_cast<const Uint8*>(&modulate);
+                Uint8 source[4];
+
+                for (unsigned int i = 0; i < count; ++i)
+                {
+                    _Modulate(source, reinterpret_cast<const Uint8*>(src + i), factors);
+                    _BlendPixel(reinterpret_cast<Uint8*>(dst + i), source);
+                }
+            }
+
+            static void _BlendMaskScalar(Uint32* dst, const Uint8* mask, unsigned int count, Uint32 color)
+            {
+                const Uint8* channels = reinterpret_cast<const Uint8*>(&color);
+                Uint8 source[4];
+
+                for (unsigned int i = 0; i < count; ++i)
+                {
+                    const Uint8 coverage[4] = { mask[i], mask[i], mask[i], mask[i] };
+
+                    _Modulate(source, channels, coverage);
+                    _BlendPixel(reinterpret_cast<Uint8*>(dst + i), source);
+                }
+            }
+
+            static void _PremultiplyScalar(Uint32* pixels, unsigned int count)
+            {
+                for (unsigned int i = 0; i < count; ++i)
+                {
+                    Uint8* pixel = reinterpret_cast<Uint8*>(pixels + i);
+                    const Uint8 factors[4] = { pixel[3], pixel[3], pixel[3], 255 };
+
+                    _Modulate(pixel, pixel, factors);
+                }
+            }
+
+            static void _ScalePixelsScalar(Uint32* dst, const Uint32* src, unsigned int count, Uint32 position, Uint32 step)
+            {
+                for (unsigned int i = 0; i < count; ++i, position += step)
+                    dst[i] = src[position >> 16];
+            }
+
+#if defined(SFUI_RASTER_X86)
+            SFUI_RASTER_TARGET("sse2") static inline __m128i  _Div255Sse2(__m128i x)
+            {
+                x = _mm_add_epi16(x, _mm_set1_epi16(128));
+                return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+            }
+
+            /** Source over of 2 premultiplied pixels with 16 bits channels */
+            SFUI_RASTER_TARGET("sse2") static inline __m128i  _OverSse2(__m128i dst, __m128i src)
+            {
+                const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+                return _mm_add_epi16(src, _Div255Sse2(_mm_mullo_epi16(dst, _mm_sub_epi16(_mm_set1_epi16(255), alpha))));
+            }
+
+            /** Source over of 4 pixels, the source being given as 2 halves of 16 bits channels */
+            SFUI_RASTER_TARGET("sse2") static inline void     _BlendSse2(Uint32* dst, __m128i sourceLow, __m128i sourceHigh)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+
+                const __m128i low = _OverSse2(_mm_unpacklo_epi8(pixels, zero), sourceLow);
+                const __m128i high = _OverSse2(_mm_unpackhi_epi8(pixels, zero), sourceHigh);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(low, high));
+            }
+
+            SFUI_RASTER_TARGET("sse2") static void    _FillSpanSse2(Uint32* dst, unsigned int count, Uint32 color)
+            {
+                const __m128i colors = _mm_set1_epi32(static_cast<int>(color));
+                unsigned int i = 0;
+
+                for (; i + 4 <= count; i += 4)
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), colors);
+
+                _FillSpanScalar(dst + i, count - i, color);
+            }
+
+            SFUI_RASTER_TARGET("sse2") static void    _BlendSpanSse2(Uint32* dst, unsigned int count, Uint32 color)
+            {
+                const __m128i source = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color)), _mm_setzero_si128());
+                unsigned int i = 0;
+
+                for (; i + 4 <= count; i += 4)
+                    _BlendSse2(dst + i, source, source);
+
+                _BlendSpanScalar(dst + i, count - i, color);
+            }
+
+            SFUI_RASTER_TARGET("sse2") static void    _BlendPixelsSse2(Uint32* dst, const Uint32* src, unsigned int count, Uint32 modulate)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i factor = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(modulate)), zero);
+                unsigned int i = 0;
+
+                for (; i + 4 <= count; i += 4)
+                {
+                    const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+                    _BlendSse2(dst + i, _Div255Sse2(_mm_mullo_epi16(_mm_unpacklo_epi8(source, zero), factor)),
+                                        _Div255Sse2(_mm_mullo_epi16(_mm_unpackhi_epi8(source, zero), factor)));
+                }
+
+                _BlendPixelsScalar(dst + i, src + i, count - i, modulate);
+            }
+
+            SFUI_RASTER_TARGET("sse2") static void    _BlendMaskSse2(Uint32* dst, const Uint8* mask, unsigned int count, Uint32 color)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i source = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color)), zero);
+                unsigned int i = 0;
+
+                for (; i + 4 <= count; i += 4)
+                {
+                    int bytes;
+                    std::memcpy(&bytes, mask + i, sizeof(bytes));
+
+                    // Empty coverage leaves the destination unchanged
+                    if (bytes == 0)
+                        continue;
+
+                    // Spread each coverage byte over the 4 channels of its pixel
+                    __m128i coverage = _mm_cvtsi32_si128(bytes);
+                    coverage = _mm_unpacklo_epi8(coverage, coverage);
+                    coverage = _mm_unpacklo_epi16(coverage, coverage);
+
+                    _BlendSse2(dst + i, _Div255Sse2(_mm_mullo_epi16(_mm_unpacklo_epi8(coverage, zero), source)),
+                                        _Div255Sse2(_mm_mullo_epi16(_mm_unpackhi_epi8(coverage, zero), source)));
+                }
+
+                _BlendMaskScalar(dst + i, mask + i, count - i, color);
+            }
+
+            SFUI_RASTER_TARGET("sse2") static void    _PremultiplySse2(Uint32* pixels, unsigned int count)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i colorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+                const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+                unsigned int i = 0;
+
+                for (; i + 4 <= count; i += 4)
+                {
+                    const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+                    __m128i halves[2] = { _mm_unpacklo_epi8(source, zero), _mm_unpackhi_epi8(source, zero) };
+
+                    for (unsigned int h = 0; h < 2; ++h)
+                    {
+                        // Color channels are multiplied by the alpha, the alpha by 255
+                        __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(halves[h], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+                        alpha = _mm_or_si128(_mm_and_si128(alpha, colorMask), opaque);
+
+                        halves[h] = _Div255Sse2(_mm_mullo_epi16(halves[h], alpha));
+                    }
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), _mm_packus_epi16(halves[0], halves[1]));
+                }
+
+                _PremultiplyScalar(pixels + i, count - i);
+            }
+
+            SFUI_RASTER_TARGET("avx2") static inline __m256i  _Div255Avx2(__m256i x)
+            {
+                x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+                return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+            }
+
+            SFUI_RASTER_TARGET("avx2") static inline __m256i  _OverAvx2(__m256i dst, __m256i src)
+            {
+                const __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+                return _mm256_add_epi16(src, _Div255Avx2(_mm256_mullo_epi16(dst, _mm256_sub_epi16(_mm256_set1_epi16(255), alpha))));
+            }
+
+            /** Source over of 8 pixels, unpacked and packed inside each 128 bits lane */
+            SFUI_RASTER_TARGET("avx2") static inline void     _BlendAvx2(Uint32* dst, __m256i sourceLow, __m256i sourceHigh)
+            {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+
+                const __m256i low = _OverAvx2(_mm256_unpacklo_epi8(pixels, zero), sourceLow);
+                const __m256i high = _OverAvx2(_mm256_unpackhi_epi8(pixels, zero), sourceHigh);
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_packus_epi16(low, high));
+            }
+
+            SFUI_RASTER_TARGET("avx2") static void    _FillSpanAvx2(Uint32* dst, unsigned int count, Uint32 color)
+            {
+                const __m256i colors = _mm256_set1_epi32(static_cast<int>(color));
+                unsigned int i = 0;
+
+                for (; i + 8 <= count; i += 8)
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), colors);
+
+                _FillSpanScalar(dst + i, count - i, color);
+            }
+
+            SFUI_RASTER_TARGET("avx2") static void    _BlendSpanAvx2(Uint32* dst, unsigned int count, Uint32 color)
+            {
+                const __m256i source = _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(color)), _mm256_setzero_si256());
+                unsigned int i = 0;
+
+                for (; i + 8 <= count; i += 8)
+                    _BlendAvx2(dst + i, source, source);
+
+                _BlendSpanScalar(dst + i, count - i, color);
+            }
+
+            SFUI_RASTER_TARGET("avx2") static void    _BlendPixelsAvx2(Uint32* dst, const Uint32* src, unsigned int count, Uint32 modulate)
+            {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i factor = _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(modulate)), zero);
+                unsigned int i = 0;
+
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+
+                    _BlendAvx2(dst + i, _Div255Avx2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(source, zero), factor)),
+                                        _Div255Avx2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(source, zero), factor)));
+                }
+
+                _BlendPixelsScalar(dst + i, src + i, count - i, modulate);
+            }
+
+            SFUI_RASTER_TARGET("avx2") static void    _BlendMaskAvx2(Uint32* dst, const Uint8* mask, unsigned int count, Uint32 color)
+            {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i source = _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(color)), zero);
+                const __m256i spread = _mm256_set1_epi32(0x01010101);
+                unsigned int i = 0;
+
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(mask + i));
+
+                    // Empty coverage leaves the destination unchanged
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_setzero_si128())) == 0xFFFF)
+                        continue;
+
+                    // One coverage per 32 bits, multiplied to fill the 4 channels
+                    const __m256i coverage = _mm256_mullo_epi32(_mm256_cvtepu8_epi32(bytes), spread);
+
+                    _BlendAvx2(dst + i, _Div255Avx2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(coverage, zero), source)),
+                                        _Div255Avx2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(coverage, zero), source)));
+                }
+
+                _BlendMaskScalar(dst + i, mask + i, count - i, color);
+            }
+
+            SFUI_RASTER_TARGET("avx2") static void    _PremultiplyAvx2(Uint32* pixels, unsigned int count)
+            {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i colorMask = _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1);
+                const __m256i opaque = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+                unsigned int i = 0;
+
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+                    __m256i halves[2] = { _mm256_unpacklo_epi8(source, zero), _mm256_unpackhi_epi8(source, zero) };
+
+                    for (unsigned int h = 0; h < 2; ++h)
+                    {
+                        __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(halves[h], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+                        alpha = _mm256_or_si256(_mm256_and_si256(alpha, colorMask), opaque);
+
+                        halves[h] = _Div255Avx2(_mm256_mullo_epi16(halves[h], alpha));
+                    }
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), _mm256_packus_epi16(halves[0], halves[1]));
+                }
+
+                _PremultiplyScalar(pixels + i, count - i);
+            }
+
+            SFUI_RASTER_TARGET("avx2") static void    _ScalePixelsAvx2(Uint32* dst, const Uint32* src, unsigned int count, Uint32 position, Uint32 step)
+            {
+                const __m256i advance = _mm256_set1_epi32(static_cast<int>(step * 8));
+                __m256i positions = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(position)),
+                                                     _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(step)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+                unsigned int i = 0;
+
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m256i indices = _mm256_srli_epi32(positions, 16);
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_i32gather_epi32(reinterpret_cast<const int*>(src), indices, 4));
+                    positions = _mm256_add_epi32(positions, advance);
+                }
+
+                _ScalePixelsScalar(dst + i, src, count - i, position + i * step, step);
+            }
+#endif
+
+            /** Kernels of one instruction set */
+            struct _KernelTable
+            {
+                void    (*blendMask)(Uint32*, const Uint8*, unsigned int, Uint32);
+                void    (*blendPixels)(Uint32*, const Uint32*, unsigned int, Uint32);
+                void    (*blendSpan)(Uint32*, unsigned int, Uint32);
+                void    (*fillSpan)(Uint32*, unsigned int, Uint32);
+                void    (*premultiply)(Uint32*, unsigned int);
+                void    (*scalePixels)(Uint32*, const Uint32*, unsigned int, Uint32, Uint32);
+                const char* name;
+            };
+
+            static const _KernelTable _kernelTables[] =
+            {
+                { _BlendMaskScalar, _BlendPixelsScalar, _BlendSpanScalar, _FillSpanScalar, _PremultiplyScalar, _ScalePixelsScalar, "scalar" },
+#if defined(SFUI_RASTER_X86)
+                // SSE2 has no gather, scaling stays scalar
+                { _BlendMaskSse2, _BlendPixelsSse2, _BlendSpanSse2, _FillSpanSse2, _PremultiplySse2, _ScalePixelsScalar, "sse2" },
+                { _BlendMaskAvx2, _BlendPixelsAvx2, _BlendSpanAvx2, _FillSpanAvx2, _PremultiplyAvx2, _ScalePixelsAvx2, "avx2" }
+#endif
+            };
+
+            static bool     _IsSupported(Kernels kernels)
+            {
+                if (kernels == SCALAR)
+                    return true;
+
+#if defined(SFUI_RASTER_X86) && defined(__GNUC__)
+                __builtin_cpu_init();
+
+                if (kernels == SSE2)
+                    return __builtin_cpu_supports("sse2");
+                if (kernels == AVX2)
+                    return __builtin_cpu_supports("avx2");
+#elif defined(SFUI_RASTER_X86)
+                int info[4];
+
+                __cpuid(info, 1);
+                const bool sse2 = (info[3] & (1 << 26)) != 0;
+                const bool osAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6);
+
+                if (kernels == SSE2)
+                    return sse2;
+
+                __cpuidex(info, 7, 0);
+                if (kernels == AVX2)
+                    return osAvx && (info[1] & (1 << 5));
+#endif
+                return false;
+            }
+
+            static Kernels  _current = SCALAR;
+            static const _KernelTable* _table = 0;
+
+            /** Kernels in use, the best supported ones are selected on first call */
+            static const _KernelTable&  _GetTable()
+            {
+                if (!_table)
+                {
+                    Kernels best = SCALAR;
+
+                    if (_IsSupported(AVX2))
+                        best = AVX2;
+                    else if (_IsSupported(SSE2))
+                        best = SSE2;
+
+                    SetKernels(best);
+                }
+                return *_table;
+            }
+
+            bool    SetKernels(Kernels kernels)
+            {
+                if (!_IsSupported(kernels))
+                    return false;
+
+                _current = kernels;
+                _table = &_kernelTables[kernels];
+                return true;
+            }
+
+            Kernels     GetKernels()
+            {
+                _GetTable();
+                return _current;
+            }
+
+            const char* GetKernelName()
+            {
+                return _GetTable().name;
+            }
+
+            Uint32  PackColor(const Color& color)
+            {
+                const Uint8 bytes[4] = { static_cast<Uint8>(_Div255(color.r * color.a)),
+                                         static_cast<Uint8>(_Div255(color.g * color.a)),
+                                         static_cast<Uint8>(_Div255(color.b * color.a)),
+                                         color.a };
+                Uint32 pixel;
+
+                std::memcpy(&pixel, bytes, sizeof(pixel));
+                return pixel;
+            }
+
+            void    FillSpan(Uint32* dst, unsigned int count, Uint32 color)
+            {
+                _GetTable().fillSpan(dst, count, color);
+            }
+
+            void    BlendSpan(Uint32* dst, unsigned int count, Uint32 color)
+            {
+                const Uint8 alpha = reinterpret_cast<const Uint8*>(&color)[3];
+
+                if (alpha == 255)
+                    _GetTable().fillSpan(dst, count, color);
+                else if (alpha > 0)
+                    _GetTable().blendSpan(dst, count, color);
+            }
+
+            void    BlendPixels(Uint32* dst, const Uint32* src, unsigned int count, Uint32 modulate)
+            {
+                _GetTable().blendPixels(dst, src, count, modulate);
+            }
+
+            void    BlendMask(Uint32* dst, const Uint8* mask, unsigned int count, Uint32 color)
+            {
+                if (reinterpret_cast<const Uint8*>(&color)[3] > 0)
+                    _GetTable().blendMask(dst, mask, count, color);
+            }
+
+            void    Premultiply(Uint32* pixels, unsigned int count)
+            {
+                _GetTable().premultiply(pixels, count);
+            }
+
+            void    ScalePixels(Uint32* dst, const Uint32* src, unsigned int count, Uint32 position, Uint32 step)
+            {
+                _GetTable().scalePixels(dst, src, count, position, step);
+            }
+
+            void    Unpremultiply(Uint32* pixels, unsigned int count)
+            {
+                for (unsigned int i = 0; i < count; ++i)
+                {
+                    Uint8* pixel = reinterpret_cast<Uint8*>(pixels + i);
+                    const unsigned int alpha = pixel[3];
+
+                    if (alpha == 0 || alpha == 255)
+                        continue;
+
+                    for (unsigned int c = 0; c < 3; ++c)
+                        pixel[c] = static_cast<Uint8>(std::min(255u, (pixel[c] * 255 + alpha / 2) / alpha));
+                }
+            }
+        }
+
+    }
+
+}
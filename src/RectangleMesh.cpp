@@ -0,0 +1,133 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <SFML/Graphics/RenderQueue.hpp>
+
+#include <SFUI/RectangleMesh.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        RectangleMesh::RectangleMesh(const Vector2f& size, const Color& fillColor, float outline, const Color& outlineColor)
+            :   Drawable(),
+                mFillColor(fillColor),
+                mOutline(-1.f),
+                mOutlineColor(outlineColor)
+        {
+            SetGeometry(size, outline);
+        }
+
+        const Color&    RectangleMesh::GetFillColor() const
+        {
+            return mFillColor;
+        }
+
+        float   RectangleMesh::GetOutline() const
+        {
+            return mOutline;
+        }
+
+        const Color&    RectangleMesh::GetOutlineColor() const
+        {
+            return mOutlineColor;
+        }
+
+        const Vector2f&     RectangleMesh::GetSize() const
+        {
+            return mSize;
+        }
+
+        void    RectangleMesh::SetColors(const Color& fillColor, const Color& outlineColor)
+        {
+            mFillColor = fillColor;
+            mOutlineColor = outlineColor;
+        }
+
+        void    RectangleMesh::SetGeometry(const Vector2f& size, float outline)
+        {
+            if (size == mSize && outline == mOutline)
+                return;
+
+            mSize = size;
+            mOutline = outline;
+
+            // The rectangle corners, then the outline outer corners
+            mPoints[0] = Vector2f(0.f, 0.f);
+            mPoints[1] = Vector2f(size.x, 0.f);
+            mPoints[2] = Vector2f(size.x, size.y);
+            mPoints[3] = Vector2f(0.f, size.y);
+
+            mPoints[4] = Vector2f(-outline, -outline);
+            mPoints[5] = Vector2f(size.x + outline, -outline);
+            mPoints[6] = Vector2f(size.x + outline, size.y + outline);
+            mPoints[7] = Vector2f(-outline, size.y + outline);
+        }
+
+        void    RectangleMesh::Render(RenderTarget&, RenderQueue& queue) const
+        {
+            const bool fill = (mFillColor.a > 0);
+            const bool outline = (mOutline > 0.f && mOutlineColor.a > 0);
+
+            if (!fill && !outline)
+                return;
+
+            queue.SetTexture(0);
+            queue.BeginBatch();
+
+            unsigned int count = 0;
+
+            if (fill)
+            {
+                for (unsigned int i = 0; i < 4; ++i)
+                    queue.AddVertex(mPoints[i].x, mPoints[i].y, 0.f, 0.f, mFillColor);
+
+                queue.AddTriangle(0, 1, 2);
+                queue.AddTriangle(0, 2, 3);
+                count = 4;
+            }
+
+            if (outline)
+            {
+                for (unsigned int i = 0; i < 8; ++i)
+                    queue.AddVertex(mPoints[i].x, mPoints[i].y, 0.f, 0.f, mOutlineColor);
+
+                // A quad between each inner edge and its outer edge
+                for (unsigned int i = 0; i < 4; ++i)
+                {
+                    const unsigned int next = (i + 1) % 4;
+
+                    queue.AddTriangle(count + i, count + 4 + i, count + 4 + next);
+                    queue.AddTriangle(count + i, count + 4 + next, count + next);
+                }
+            }
+        }
+
+    }
+
+}
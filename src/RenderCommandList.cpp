@@ -0,0 +1,280 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderQueue.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include <SFUI/DistanceFieldFont.hpp>
+#include <SFUI/RenderCommandList.hpp>
+#include <SFUI/ResourceManager.hpp>
+#include <SFUI/Widget.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** Get the next element of an array, reusing the elements of the previous frames */
+        template <typename T>
+        static T&   _NextSlot(std::vector<T>& items, unsigned int& count)
+        {
+            if (count == items.size())
+                items.push_back(T());
+            return items[count++];
+        }
+
+        RenderCommandList::RenderCommandList()
+            :   Drawable(),
+                mSliceCount(0),
+                mSpriteCount(0),
+                mStringCount(0),
+                mTextCount(0)
+        {
+
+        }
+
+        void    RenderCommandList::Clear()
+        {
+            mCommands.clear();
+            mSliceCount = 0;
+            mSpriteCount = 0;
+            mStringCount = 0;
+            mTextCount = 0;
+        }
+
+        unsigned int    RenderCommandList::GetCommandCount() const
+        {
+            return static_cast<unsigned int>(mCommands.size());
+        }
+
+        void    RenderCommandList::Record(const Widget& widget)
+        {
+            Clear();
+
+            RecordingPainter painter(*this);
+
+            // The origin is the absolute position of the widget parent
+            painter.Translate(widget.GetAbsolutePosition() - widget.GetPosition());
+            widget.Paint(painter);
+        }
+
+        void    RenderCommandList::Flush(RenderTarget& target, RenderQueue& queue) const
+        {
+            if (mClips.empty())
+            {
+                queue.SetScissor(false);
+            }
+            else
+            {
+                const FloatRect& top = mClips.back();
+                queue.SetScissor(true, Vector2f(top.Left, target.GetHeight() - top.Bottom), Vector2f(top.GetSize().x, top.GetSize().y));
+            }
+            target.Flush();
+        }
+
+        void    RenderCommandList::Render(RenderTarget& target, RenderQueue& queue) const
+        {
+            mClips.clear();
+
+            for (std::vector<Command>::const_iterator it = mCommands.begin(); it != mCommands.end(); ++it)
+            {
+                switch (it->Type)
+                {
+                    case FILL_RECT :
+                    {
+                        RectangleMesh& mesh = (it->Outline > 0.f) ? mMesh : mUnitQuad;
+
+                        // Same geometry as SfmlPainter::FillRect()
+                        mesh.SetPosition(it->Rect.Left, it->Rect.Top);
+
+                        if (it->Outline > 0.f)
+                        {
+                            mesh.SetGeometry(it->Rect.GetSize(), it->Outline);
+                            mesh.SetColors(it->FillColor, it->OutlineColor);
+                        }
+                        else
+                        {
+                            mesh.SetScale(it->Rect.GetSize());
+                            mesh.SetColor(it->FillColor);
+                        }
+                        target.Draw(mesh);
+                        break;
+                    }
+
+                    case DRAW_NINE_SLICE :
+                        queue.SetColor(mSlices[it->Index].GetColor());
+                        target.Draw(mSlices[it->Index]);
+                        break;
+
+                    case DRAW_SPRITE :
+                        queue.SetColor(mSprites[it->Index].GetColor());
+                        target.Draw(mSprites[it->Index]);
+                        break;
+
+                    case DRAW_STRING :
+                        queue.SetColor(mStrings[it->Index].GetColor());
+                        target.Draw(mStrings[it->Index]);
+                        break;
+
+                    case DRAW_TEXT :
+                        queue.SetColor(mTexts[it->Index].GetColor());
+                        target.Draw(mTexts[it->Index]);
+                        break;
+
+                    // Drawings queued before a clipping area belong to the enclosing one
+                    case PUSH_CLIP :
+                        Flush(target, queue);
+                        mClips.push_back(it->Rect);
+                        break;
+
+                    case POP_CLIP :
+                        Flush(target, queue);
+                        if (!mClips.empty())
+                            mClips.pop_back();
+                        break;
+                }
+            }
+
+            Flush(target, queue);
+        }
+
+        RecordingPainter::RecordingPainter(RenderCommandList& list)
+            :   mList(list)
+        {
+
+        }
+
+        RenderCommandList::Command&     RecordingPainter::AddCommand(RenderCommandList::CommandType type)
+        {
+            mList.mCommands.push_back(RenderCommandList::Command());
+
+            RenderCommandList::Command& command = mList.mCommands.back();
+            command.Type = type;
+            command.Index = 0;
+            command.Outline = 0.f;
+            return command;
+        }
+
+        void    RecordingPainter::DrawNineSlice(const NineSlice& slice)
+        {
+            AddCommand(RenderCommandList::DRAW_NINE_SLICE).Index = mList.mSliceCount;
+
+            NineSlice& copy = _NextSlot(mList.mSlices, mList.mSliceCount);
+            copy = slice;
+            copy.SetPosition(mOrigin + slice.GetPosition());
+            copy.SetColor(ApplyOpacity(slice.GetColor()));
+        }
+
+        void    RecordingPainter::DrawSprite(const Sprite& sprite)
+        {
+            AddCommand(RenderCommandList::DRAW_SPRITE).Index = mList.mSpriteCount;
+
+            Sprite& copy = _NextSlot(mList.mSprites, mList.mSpriteCount);
+            copy = sprite;
+            copy.SetPosition(mOrigin + sprite.GetPosition());
+            copy.SetColor(ApplyOpacity(sprite.GetColor()));
+        }
+
+        void    RecordingPainter::DrawString(const String& string)
+        {
+            const Font& font = string.GetFont();
+
+            // Scaled strings are laid out now, the resource manager isn't used while drawing the list
+            if (string.GetSize() != static_cast<float>(font.GetCharacterSize()))
+            {
+                const DistanceFieldFont* field = ResourceManager::Get()->GetDistanceField(font);
+
+                if (field)
+                {
+                    AddCommand(RenderCommandList::DRAW_TEXT).Index = mList.mTextCount;
+
+                    DistanceFieldText& text = _NextSlot(mList.mTexts, mList.mTextCount);
+                    text.SetString(*field, string);
+                    text.SetPosition(mOrigin + string.GetPosition());
+                    text.SetColor(ApplyOpacity(string.GetColor()));
+                    return;
+                }
+            }
+
+            AddCommand(RenderCommandList::DRAW_STRING).Index = mList.mStringCount;
+
+            String& copy = _NextSlot(mList.mStrings, mList.mStringCount);
+            copy = string;
+            copy.SetPosition(mOrigin + string.GetPosition());
+            copy.SetColor(ApplyOpacity(string.GetColor()));
+        }
+
+        void    RecordingPainter::FillRect(const FloatRect& rect, const Color& rectColor, float outline, const Color& rectOutlineColor)
+        {
+            const Color color = ApplyOpacity(rectColor);
+            const Color outlineColor = ApplyOpacity(rectOutlineColor);
+            const bool fill = (color.a > 0);
+            const bool border = (outline > 0.f && outlineColor.a > 0);
+
+            if (!fill && !border)
+                return;
+
+            RenderCommandList::Command& command = AddCommand(RenderCommandList::FILL_RECT);
+
+            command.Rect = FloatRect(mOrigin.x + rect.Left, mOrigin.y + rect.Top, mOrigin.x + rect.Right, mOrigin.y + rect.Bottom);
+            command.FillColor = color;
+            command.Outline = border ? outline : 0.f;
+            command.OutlineColor = outlineColor;
+        }
+
+        void    RecordingPainter::PopClip()
+        {
+            if (!mClips.empty())
+                mClips.pop_back();
+
+            AddCommand(RenderCommandList::POP_CLIP);
+        }
+
+        void    RecordingPainter::PushClip(const FloatRect& rect)
+        {
+            FloatRect clip(mOrigin.x + rect.Left, mOrigin.y + rect.Top, mOrigin.x + rect.Right, mOrigin.y + rect.Bottom);
+
+            if (!mClips.empty())
+            {
+                const FloatRect& top = mClips.back();
+
+                clip.Left = std::max(clip.Left, top.Left);
+                clip.Top = std::max(clip.Top, top.Top);
+                clip.Right = std::max(clip.Left, std::min(clip.Right, top.Right));
+                clip.Bottom = std::max(clip.Top, std::min(clip.Bottom, top.Bottom));
+            }
+
+            mClips.push_back(clip);
+            AddCommand(RenderCommandList::PUSH_CLIP).Rect = clip;
+        }
+
+    }
+
+}
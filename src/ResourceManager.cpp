@@ -28,16 +28,33 @@
 
 
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <set>
 #include <vector>
 
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(__linux__)
+    #include <fcntl.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/Sprite.hpp>
+#include <SFML/System/Clock.hpp>
 
+#include <SFUI/DistanceFieldFont.hpp>
+#include <SFUI/Profiler.hpp>
 #include <SFUI/ResourceManager.hpp>
-
-#include <TinyXML/tinyxml.h>
+#include <SFUI/SkinFile.hpp>
+#include <SFUI/StyleReader.hpp>
+#include <SFUI/TaskPool.hpp>
+#include <SFUI/Widget.hpp>
 
 namespace sf
 {
@@ -55,13 +72,18 @@ namespace sf
         }
 
         ResourceManager::ResourceManager()
+            :   mHotReload(false),
+                mNotifyFd(-1)
         {
 
         }
 
         ResourceManager::~ResourceManager()
         {
-            for (Fonts::iterator it = mFonts.begin(); it != mFonts.end(); ++it)
+            EnableHotReload(false);
+
+            // Aliases share the fonts of the cache
+            for (std::map<std::pair<std::string, unsigned int>, Font*>::iterator it = mFontCache.begin(); it != mFontCache.end(); ++it)
             {
                 delete it->second;
             }
@@ -71,8 +93,17 @@ namespace sf
                 delete it->second;
             }
 
+            for (std::map<std::string, DistanceFieldFont*>::iterator it = mDistanceFields.begin(); it != mDistanceFields.end(); ++it)
+            {
+                delete it->second;
+            }
+
+            mSprites.clear();
+            mFontCache.clear();
             mFonts.clear();
+            mFontAliases.clear();
             mImages.clear();
+            mImageFiles.clear();
         }
 
         void ResourceManager::Kill()
@@ -120,10 +151,50 @@ namespace sf
 
         Color   ResourceManager::GetColorValue(const std::string& value, const Color& defaultValue)
         {
-            Color   retValue;
+            ParsedValues::const_iterator parsed = mParsedValues.find(value);
+
+            if (parsed != mParsedValues.end())
+                return (parsed->second.HasColor) ? parsed->second.ColorValue : defaultValue;
+
+            Color   color;
+
+            return (ParseColor(value, color)) ? color : defaultValue;
+        }
+
+        bool    ResourceManager::GetValue(const std::string& value, const bool& defaultValue)
+        {
+            ParsedValues::const_iterator parsed = mParsedValues.find(value);
+
+            if (parsed != mParsedValues.end())
+                return (parsed->second.HasBool) ? parsed->second.Bool : defaultValue;
+
+            return GetValue<bool>(value, defaultValue);
+        }
+
+        float   ResourceManager::GetValue(const std::string& value, const float& defaultValue)
+        {
+            ParsedValues::const_iterator parsed = mParsedValues.find(value);
+
+            if (parsed != mParsedValues.end())
+                return (parsed->second.HasFloat) ? parsed->second.Float : defaultValue;
+
+            return GetValue<float>(value, defaultValue);
+        }
+
+        int     ResourceManager::GetValue(const std::string& value, const int& defaultValue)
+        {
+            ParsedValues::const_iterator parsed = mParsedValues.find(value);
 
+            if (parsed != mParsedValues.end())
+                return (parsed->second.HasInt) ? parsed->second.Int : defaultValue;
+
+            return GetValue<int>(value, defaultValue);
+        }
+
+        bool    ResourceManager::ParseColor(const std::string& value, Color& retValue)
+        {
             if (value.length() == 0)
-                return defaultValue;
+                return false;
 
             if (value.substr(0, 1) == "#" && value.length() == 7)
             {
@@ -132,7 +203,7 @@ namespace sf
                 retValue.b = _GetElementFromHex(value.substr(5, 2));
                 retValue.a = 255;
 
-                return retValue;
+                return true;
             }
             else if (value.substr(0, 4) == "rgb:")
             {
@@ -146,7 +217,7 @@ namespace sf
                     retValue.b = GetValue(vectEls[2], 255);
                     retValue.a = 255;
 
-                    return retValue;
+                    return true;
                 }
             }
             else if (value.substr(0, 5) == "rgba:")
@@ -161,10 +232,10 @@ namespace sf
                     retValue.b = GetValue(vectEls[2], 255);
                     retValue.a = GetValue(vectEls[3], 255);
 
-                    return retValue;
+                    return true;
                 }
             }
-            return (retValue = defaultValue);
+            return false;
         }
 
         StyleProperties&   ResourceManager::GetStyle(const std::string& name)
@@ -174,24 +245,61 @@ namespace sf
 
         bool      ResourceManager::LoadFont(const std::string& resId, const std::string& filename, float size)
         {
-            Font* font = new Font();
-            if (font->LoadFromFile(filename, size))
+            Font* font = LoadFontFile(filename, size);
+            if (font)
             {
                 mFonts[resId] = font;
+                mFontAliases[resId] = std::make_pair(filename, size);
                 return true;
             }
             return false;
         }
 
+        Font*     ResourceManager::LoadFontFile(const std::string& filename, float size)
+        {
+            const std::pair<std::string, unsigned int> key(filename, static_cast<unsigned int>(size));
+            std::map<std::pair<std::string, unsigned int>, Font*>::const_iterator cached = mFontCache.find(key);
+
+            if (cached != mFontCache.end())
+                return cached->second;
+
+            Font* font = new Font();
+            if (font->LoadFromFile(filename, key.second))
+            {
+                Profiler::Count(Profiler::FONT_LOADS);
+                mFontCache[key] = font;
+                mFontFiles[font] = filename;
+                return font;
+            }
+            delete font;
+            return 0;
+        }
+
         bool    ResourceManager::LoadImage(const std::string& resId, const std::string& filename)
         {
             Image* image = new Image();
-            if (image->LoadFromFile(filename))
+            if (!image->LoadFromFile(filename))
+            {
+                delete image;
+                return false;
+            }
+
+            Images::iterator loaded = mImages.find(resId);
+
+            if (loaded != mImages.end())
+            {
+                // Sprites of the widgets point to the image : a redefined alias is replaced in place
+                *loaded->second = *image;
+                delete image;
+                mSprites.clear();
+            }
+            else
             {
                 mImages[resId] = image;
-                return true;
             }
-            return false;
+
+            mImageFiles[resId] = filename;
+            return true;
         }
 
         Font*     ResourceManager::GetFont(const std::string& name, float size)
@@ -199,21 +307,29 @@ namespace sf
             if (name == "")
                 return 0;
 
-            Font*   font = 0;
-            Fonts::iterator it = mFonts.find(name);
+            const std::pair<std::string, unsigned int> key = ResolveFont(name, size);
 
-            if (it != mFonts.end())
-                font = it->second;
-            else
-            {
-                if (LoadFont(name, name, size))
-                    return mFonts[name];
-            }
-            return font;
+            return LoadFontFile(key.first, static_cast<float>(key.second));
+        }
+
+        std::pair<std::string, unsigned int>    ResourceManager::ResolveFont(const std::string& name, float size) const
+        {
+            // Aliases name a file and a size : fonts are looked up by file and size
+            std::map<std::string, std::pair<std::string, float> >::const_iterator alias = mFontAliases.find(name);
+
+            if (alias == mFontAliases.end())
+                return std::make_pair(name, static_cast<unsigned int>((size > 0.f) ? size : 30.f));
+
+            return std::make_pair(alias->second.first, static_cast<unsigned int>((size > 0.f) ? size : alias->second.second));
         }
 
         Sprite  ResourceManager::GetImage(const std::string& name)
         {
+            Sprites::const_iterator cached = mSprites.find(name);
+
+            if (cached != mSprites.end())
+                return cached->second;
+
             Sprite spr;
             IntRect rect;
             std::vector<std::string> rectElems;
@@ -254,78 +370,802 @@ namespace sf
 
             spr.SetSubRect(rect);
 
+            // Only successful resolutions are kept, a missing file is tried again next time
+            if (image)
+                mSprites[name] = spr;
+
             return spr;
         }
 
+        DistanceFieldFont*  ResourceManager::GetDistanceField(const Font& font)
+        {
+            std::map<const Font*, std::string>::const_iterator file = mFontFiles.find(&font);
+
+            if (file == mFontFiles.end())
+                return 0;
+
+            std::map<std::string, DistanceFieldFont*>::const_iterator it = mDistanceFields.find(file->second);
+
+            if (it != mDistanceFields.end())
+                return it->second;
+
+            // Failures are kept too, so that the file isn't loaded again for each string
+            DistanceFieldFont* field = new DistanceFieldFont(mGlyphAtlas);
+
+            if (!field->LoadFromFile(file->second))
+            {
+                delete field;
+                field = 0;
+            }
+
+            mDistanceFields[file->second] = field;
+            return field;
+        }
+
+
+        /** Style reader feeding the ResourceManager tables */
+        class _StyleLoader : public StyleReader
+        {
+            public :
+
+                _StyleLoader(ResourceManager& manager, Styles& styles, std::set<std::string>& names)
+                    :   Redefined(),
+                        mManager(manager),
+                        mStyles(styles),
+                        mNames(names)
+                {}
+
+                // Aliases already loaded from another file (or at another size), which were loaded again
+                std::set<std::string>   Redefined;
+
+            protected :
+
+                virtual void    OnResource(const std::string& type, const std::string& name, const std::string& src, float size)
+                {
+                    // Aliases defined the same way again are not loaded twice
+                    if (type == "font")
+                    {
+                        std::map<std::string, std::pair<std::string, float> >::const_iterator alias = mManager.mFontAliases.find(name);
+
+                        if (alias == mManager.mFontAliases.end())
+                            mManager.LoadFont(name, src, size);
+                        else if (alias->second != std::make_pair(src, size) && mManager.LoadFont(name, src, size))
+                            Redefined.insert(name);
+                    }
+                    else if (type == "image")
+                    {
+                        std::map<std::string, std::string>::const_iterator alias = mManager.mImageFiles.find(name);
+
+                        if (alias == mManager.mImageFiles.end())
+                            mManager.LoadImage(name, src);
+                        else if (alias->second != src && mManager.LoadImage(name, src))
+                            Redefined.insert(name);
+                    }
+                }
+
+                virtual void    OnStyle(const std::string& name, StyleProperties& properties)
+                {
+                    mNames.insert(name);
+                    mStyles[name].swap(properties);
+                }
+
+            private :
+
+                ResourceManager&        mManager;
+
+                Styles&                 mStyles;
+
+                std::set<std::string>&  mNames;
+        };
+
+        /** Add the styles using one of some resource aliases to a set of changed styles */
+        static void    _AddAliasUsers(const Styles& styles, const std::set<std::string>& aliases, std::set<std::string>& changed)
+        {
+            if (aliases.empty())
+                return;
+
+            for (Styles::const_iterator style = styles.begin(); style != styles.end(); ++style)
+            {
+                for (StyleProperties::const_iterator it = style->second.begin(); it != style->second.end(); ++it)
+                {
+                    // Sub-images name their image first : "sub:image,left,top,right,bottom"
+                    const std::string& value = it->second;
+                    const std::string resource = (value.compare(0, 4, "sub:") == 0) ? value.substr(4, value.find(',') - 4) : value;
+
+                    if (aliases.count(resource) > 0)
+                    {
+                        changed.insert(style->first);
+                        break;
+                    }
+                }
+            }
+        }
+
+        static long _GetModificationTime(const std::string& filename)
+        {
+            struct stat info;
+
+            if (stat(filename.c_str(), &info) != 0)
+                return 0;
+            return static_cast<long>(info.st_mtime);
+        }
+
         bool    ResourceManager::AddStylesFromFile(const std::string& filename)
         {
-            TiXmlDocument file(filename);
+            StyleFile       file;
+            _StyleLoader    loader(*this, mStyles, file.Names);
+
+            if (!loader.Read(filename))
+                return false;
+
+            file.ModificationTime = _GetModificationTime(filename);
+            mStyleFiles[filename] = file;
+
+            if (mHotReload)
+                WatchStyleFile(filename);
+
+            return true;
+        }
+
+        bool    ResourceManager::AddStylesFromSkin(const std::string& filename)
+        {
+            SkinFile skin;
 
-            if (!file.LoadFile())
+            if (!skin.Open(filename))
             {
-                std::cerr << "Could not load \"" << filename << "\" style file" << std::endl;
-                std::cerr << "Reason :" << file.ErrorDesc() << std::endl;
+                std::cerr << "Could not load \"" << filename << "\" skin file" << std::endl;
                 return false;
             }
 
-            TiXmlHandle hdlAll(&file);
-            TiXmlElement *t = hdlAll.FirstChildElement().Element();
+            for (Uint32 i = 0; i < skin.GetResourceCount(); ++i)
+            {
+                const SkinFile::Resource& res = skin.GetResource(i);
+
+                if (res.Type == SkinFile::FONT)
+                    LoadFont(skin.GetString(res.Name), skin.GetString(res.Source), res.Size);
+                else
+                    LoadImage(skin.GetString(res.Name), skin.GetString(res.Source));
+            }
+
+            // Styles and properties are sorted, so each insertion is done right after the previous one
+            Styles::iterator hint = mStyles.begin();
 
-            if (!t)
+            for (Uint32 i = 0; i < skin.GetStyleCount(); ++i)
             {
-                std::cerr << "Unable to parse style file" << std::endl;
-                return false;
+                const SkinFile::Style& style = skin.GetStyle(i);
+                StyleProperties properties;
+
+                for (Uint32 p = style.FirstProperty; p < style.FirstProperty + style.PropertyCount; ++p)
+                {
+                    const SkinFile::Property& prop = skin.GetProperty(p);
+
+                    properties.insert(properties.end(), std::make_pair(
+                        std::string(skin.GetString(prop.Key), skin.GetStringLength(prop.Key)),
+                        std::string(skin.GetString(prop.Value), skin.GetStringLength(prop.Value))));
+                }
+
+                hint = mStyles.insert(hint, std::make_pair(std::string(skin.GetString(style.Name), skin.GetStringLength(style.Name)), StyleProperties()));
+                hint->second.swap(properties);
+            }
+
+            return true;
+        }
+
+        void    ResourceManager::EnableHotReload(bool enable)
+        {
+            if (enable == mHotReload)
+                return;
+
+            mHotReload = enable;
+
+#if defined(__linux__)
+            if (enable)
+            {
+                mNotifyFd = inotify_init();
+
+                if (mNotifyFd >= 0)
+                    fcntl(mNotifyFd, F_SETFL, fcntl(mNotifyFd, F_GETFL) | O_NONBLOCK);
+
+                for (StyleFiles::const_iterator it = mStyleFiles.begin(); it != mStyleFiles.end(); ++it)
+                    WatchStyleFile(it->first);
+            }
+            else if (mNotifyFd >= 0)
+            {
+                // The watches are closed with their descriptor
+                close(mNotifyFd);
+                mNotifyFd = -1;
+                mWatchedDirs.clear();
+            }
+#endif
+            mPollClock.Reset();
+        }
+
+        bool    ResourceManager::IsHotReloadEnabled() const
+        {
+            return mHotReload;
+        }
+
+        void    ResourceManager::WatchStyleFile(const std::string& filename)
+        {
+#if defined(__linux__)
+            if (mNotifyFd < 0)
+                return;
+
+            // Directories are watched, editors often replace files instead of writing them
+            size_t slash = filename.find_last_of('/');
+            std::string dir = (slash == std::string::npos) ? "." : filename.substr(0, slash);
+
+            for (std::map<int, std::string>::const_iterator it = mWatchedDirs.begin(); it != mWatchedDirs.end(); ++it)
+            {
+                if (it->second == dir)
+                    return;
+            }
+
+            int wd = inotify_add_watch(mNotifyFd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+
+            if (wd >= 0)
+                mWatchedDirs[wd] = dir;
+#endif
+        }
+
+        unsigned int    ResourceManager::ReloadChangedStyles()
+        {
+            if (!mHotReload)
+                return 0;
+
+            std::set<std::string> dirtyFiles;
+
+#if defined(__linux__)
+            if (mNotifyFd >= 0)
+            {
+                char buffer[4096];
+                ssize_t length;
+
+                while ((length = read(mNotifyFd, buffer, sizeof(buffer))) > 0)
+                {
+                    for (ssize_t i = 0; i < length; )
+                    {
+                        const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + i);
+                        std::map<int, std::string>::const_iterator dir = mWatchedDirs.find(event->wd);
+
+                        if (event->len > 0 && dir != mWatchedDirs.end())
+                        {
+                            std::string path = (dir->second == ".") ? std::string(event->name) : dir->second + "/" + event->name;
+
+                            if (mStyleFiles.find(path) != mStyleFiles.end())
+                                dirtyFiles.insert(path);
+                        }
+                        i += sizeof(inotify_event) + event->len;
+                    }
+                }
+            }
+            else
+#endif
+            // Modification times are checked twice a second
+            if (mPollClock.GetElapsedTime() > 0.5f)
+            {
+                mPollClock.Reset();
+
+                for (StyleFiles::const_iterator it = mStyleFiles.begin(); it != mStyleFiles.end(); ++it)
+                {
+                    if (_GetModificationTime(it->first) != it->second.ModificationTime)
+                        dirtyFiles.insert(it->first);
+                }
+            }
+
+            unsigned int reloaded = 0;
+
+            for (std::set<std::string>::const_iterator it = dirtyFiles.begin(); it != dirtyFiles.end(); ++it)
+                reloaded += ReloadStylesFromFile(*it);
+
+            return reloaded;
+        }
+
+        unsigned int    ResourceManager::ReloadStylesFromFile(const std::string& filename)
+        {
+            Styles          newStyles;
+            StyleFile       newFile;
+            _StyleLoader    loader(*this, newStyles, newFile.Names);
+
+            newFile.ModificationTime = _GetModificationTime(filename);
+
+            // A broken file (often a file being saved) keeps the current styles
+            if (!loader.Read(filename))
+            {
+                mStyleFiles[filename].ModificationTime = newFile.ModificationTime;
+                return 0;
+            }
+
+            StyleFile& oldFile = mStyleFiles[filename];
+            std::set<std::string> changed;
+
+            // Removed styles (unless another file defines them too)
+            for (std::set<std::string>::const_iterator it = oldFile.Names.begin(); it != oldFile.Names.end(); ++it)
+            {
+                if (newStyles.find(*it) != newStyles.end())
+                    continue;
+
+                bool definedElsewhere = false;
+
+                for (StyleFiles::const_iterator file = mStyleFiles.begin(); file != mStyleFiles.end() && !definedElsewhere; ++file)
+                    definedElsewhere = (file->first != filename && file->second.Names.count(*it) > 0);
+
+                if (!definedElsewhere)
+                {
+                    mStyles.erase(*it);
+                    changed.insert(*it);
+                }
+            }
+
+            // Added and modified styles
+            for (Styles::iterator it = newStyles.begin(); it != newStyles.end(); ++it)
+            {
+                Styles::iterator current = mStyles.find(it->first);
+
+                if (current == mStyles.end())
+                {
+                    changed.insert(it->first);
+                    mStyles[it->first].swap(it->second);
+                }
+                else if (current->second != it->second)
+                {
+                    changed.insert(it->first);
+                    current->second.swap(it->second);
+                }
+            }
+
+            oldFile = newFile;
+
+            _AddAliasUsers(mStyles, loader.Redefined, changed);
+
+            return ApplyChangedStyles(changed);
+        }
+
+        /** Tell if a style, its parts or one of its parents is in a set of changed styles */
+        static bool    _IsStyleAffected(const Styles& styles, const std::string& name, const std::set<std::string>& changed)
+        {
+            std::string current = name;
+
+            // The depth limit protects against inheritance loops
+            for (unsigned int depth = 0; depth < 32; ++depth)
+            {
+                if (changed.find(current) != changed.end())
+                    return true;
+
+                // Parts of a style ("style->part") are loaded by the widgets using the style
+                const std::string prefix = current + "->";
+                std::set<std::string>::const_iterator part = changed.lower_bound(prefix);
+
+                if (part != changed.end() && part->compare(0, prefix.size(), prefix) == 0)
+                    return true;
+
+                Styles::const_iterator style = styles.find(current);
+
+                if (style == styles.end())
+                    return false;
+
+                StyleProperties::const_iterator from = style->second.find("from");
+
+                if (from == style->second.end() || from->second == "")
+                    return false;
+
+                current = from->second;
+            }
+            return false;
+        }
+
+        /** Styles of a theme compared with the current ones */
+        struct _StyleDiff
+        {
+            const Styles*                   Current;
+            std::vector<Styles::iterator>   Entries;
+            std::vector<char>               Changed;
+        };
+
+        static void    _CompareStyle(void* userData, size_t index)
+        {
+            _StyleDiff* diff = static_cast<_StyleDiff*>(userData);
+            Styles::const_iterator current = diff->Current->find(diff->Entries[index]->first);
+
+            diff->Changed[index] = (current == diff->Current->end() || current->second != diff->Entries[index]->second);
+        }
+
+        /** Style users resolved before their widgets are restyled */
+        struct _RestylePass
+        {
+            const Styles*                           Table;
+            const std::set<std::string>*            Changed;
+            std::vector<StyleUsers::const_iterator> Users;
+            std::vector<char>                       Affected;
+            std::set<Widget*>                       Widgets;
+            std::vector<Widget*>                    Ordered;
+            std::vector<char>                       LoadedByParent;
+        };
+
+        static void    _ResolveStyleUser(void* userData, size_t index)
+        {
+            _RestylePass* pass = static_cast<_RestylePass*>(userData);
+            const StyleUsers::const_iterator& user = pass->Users[index];
+
+            pass->Affected[index] = !user->second.empty() && _IsStyleAffected(*pass->Table, user->first, *pass->Changed);
+        }
+
+        static void    _ResolveLoadingParent(void* userData, size_t index)
+        {
+            _RestylePass* pass = static_cast<_RestylePass*>(userData);
+            const Widget* widget = pass->Ordered[index];
+            Widget* parent = widget->GetParent();
+
+            // Parts of a restyled widget ("style->part") are loaded again by their parent
+            if (parent && pass->Widgets.find(parent) != pass->Widgets.end())
+            {
+                const std::string prefix = parent->GetCurrentStyle() + "->";
+
+                pass->LoadedByParent[index] = (widget->GetCurrentStyle().compare(0, prefix.size(), prefix) == 0);
             }
+        }
+
+        void    ResourceManager::ParseStyleValue(void* userData, size_t index)
+        {
+            ParsePass* pass = static_cast<ParsePass*>(userData);
+            const std::string& value = pass->Values[index];
+            ParsedValue& parsed = pass->Parsed[index];
+
+            // Each type is parsed like GetValue() parses it
+            std::istringstream boolStream(value);
+            std::istringstream floatStream(value);
+            std::istringstream intStream(value);
+
+            parsed.HasBool = !(boolStream >> parsed.Bool).fail();
+            parsed.HasFloat = !(floatStream >> parsed.Float).fail();
+            parsed.HasInt = !(intStream >> parsed.Int).fail();
+            parsed.HasColor = pass->Manager->ParseColor(value, parsed.ColorValue);
+        }
+
+        bool    ResourceManager::IsStyleAffected(const std::string& name, const std::set<std::string>& changed) const
+        {
+            return _IsStyleAffected(mStyles, name, changed);
+        }
+
+        unsigned int    ResourceManager::ApplyChangedStyles(const std::set<std::string>& changed)
+        {
+            if (changed.empty())
+                return 0;
+
+            // Widgets to restyle are resolved on several threads : styles and widgets are only read
+            _RestylePass pass;
+            pass.Table = &mStyles;
+            pass.Changed = &changed;
+
+            for (StyleUsers::const_iterator it = mStyleUsers.begin(); it != mStyleUsers.end(); ++it)
+                pass.Users.push_back(it);
+            pass.Affected.resize(pass.Users.size(), 0);
 
-            while (t)
+            Widget::GetTaskPool()->ParallelFor(pass.Users.size(), &_ResolveStyleUser, &pass);
+
+            for (size_t i = 0; i < pass.Users.size(); ++i)
             {
-                if (t->ValueStr() == "style")
+                if (!pass.Affected[i])
+                    continue;
+
+                const std::set<Widget*>& users = pass.Users[i]->second;
+
+                for (std::set<Widget*>::const_iterator widget = users.begin(); widget != users.end(); ++widget)
                 {
-                    StyleProperties  properties;
+                    if (pass.Widgets.insert(*widget).second)
+                        pass.Ordered.push_back(*widget);
+                }
+            }
+
+            pass.LoadedByParent.resize(pass.Ordered.size(), 0);
+
+            Widget::GetTaskPool()->ParallelFor(pass.Ordered.size(), &_ResolveLoadingParent, &pass);
+
+            // The values of the affected styles and of their parents are parsed once, on several threads
+            std::set<std::string> values;
+
+            for (size_t i = 0; i < pass.Users.size(); ++i)
+            {
+                if (!pass.Affected[i])
+                    continue;
 
-                    const TiXmlAttribute* attr = t->FirstAttribute();
-                    std::string nameStyle;
+                Styles::const_iterator style = mStyles.find(pass.Users[i]->first);
 
-                    while (attr)
+                // The depth limit protects against inheritance loops
+                for (unsigned int depth = 0; depth < 32 && style != mStyles.end(); ++depth)
+                {
+                    for (StyleProperties::const_iterator prop = style->second.begin(); prop != style->second.end(); ++prop)
                     {
-                        std::string nameAttr(attr->Name());
+                        if (prop->second != "")
+                            values.insert(prop->second);
+                    }
+
+                    StyleProperties::const_iterator from = style->second.find("from");
+                    style = (from != style->second.end()) ? mStyles.find(from->second) : mStyles.end();
+                }
+            }
 
-                        if (nameAttr == "name")
-                            nameStyle = attr->ValueStr();
-                        else
-                            properties[nameAttr] = attr->ValueStr();
-                        attr = attr->Next();
+            ParsePass parse;
+            parse.Manager = this;
+            parse.Values.assign(values.begin(), values.end());
+            parse.Parsed.resize(parse.Values.size());
+
+            Widget::GetTaskPool()->ParallelFor(parse.Values.size(), &ResourceManager::ParseStyleValue, &parse);
+
+            for (size_t i = 0; i < parse.Values.size(); ++i)
+                mParsedValues.insert(mParsedValues.end(), std::make_pair(parse.Values[i], parse.Parsed[i]));
+
+            // Then the widgets are restyled on this thread. Loading a style updates the index, so widgets are collected first
+            for (size_t i = 0; i < pass.Ordered.size(); ++i)
+            {
+                if (pass.LoadedByParent[i])
+                    continue;
+
+                std::string style = pass.Ordered[i]->GetCurrentStyle();
+                pass.Ordered[i]->LoadStyle(style);
+            }
+
+            ParsedValues().swap(mParsedValues);
+
+            Profiler::Count(Profiler::STYLE_RELOADS, static_cast<unsigned int>(pass.Ordered.size()));
+
+            return static_cast<unsigned int>(pass.Ordered.size());
+        }
+
+        void    ResourceManager::SetStyleUser(Widget* widget, const std::string& oldStyle, const std::string& newStyle)
+        {
+            if (oldStyle == newStyle)
+                return;
+
+            if (oldStyle != "")
+            {
+                StyleUsers::iterator it = mStyleUsers.find(oldStyle);
+
+                if (it != mStyleUsers.end())
+                    it->second.erase(widget);
+            }
+
+            if (newStyle != "")
+                mStyleUsers[newStyle].insert(widget);
+        }
+
+        /** Resource file to be read from disk by the task pool */
+        struct _PreloadRequest
+        {
+            _PreloadRequest(const std::string& resId, const std::string& filename, bool isFont, float size)
+                :   ResId(resId), Filename(filename), IsFont(isFont), Size(size), Data()
+            {}
+
+            std::string         ResId;
+            std::string         Filename;
+            bool                IsFont;
+            float               Size;
+            std::vector<char>   Data;
+        };
+
+        static void    _ReadPreloadFile(void* userData, size_t index)
+        {
+            _PreloadRequest& request = (*static_cast<std::vector<_PreloadRequest>*>(userData))[index];
+            std::ifstream file(request.Filename.c_str(), std::ios::binary);
+
+            if (!file)
+                return;
+
+            file.seekg(0, std::ios::end);
+            std::streamoff length = file.tellg();
+            file.seekg(0, std::ios::beg);
+
+            if (length > 0)
+            {
+                request.Data.resize(static_cast<size_t>(length));
+                if (!file.read(&request.Data[0], length))
+                    request.Data.clear();
+            }
+        }
+
+        bool    ResourceManager::Preload(const std::string& filename, PreloadStats* stats)
+        {
+            PreloadStats    localStats;
+            PreloadStats&   result = (stats) ? *stats : localStats;
+            Clock           totalClock;
+            Clock           clock;
+
+            result = PreloadStats();
+
+            if (!AddStylesFromFile(filename))
+                return false;
+
+            result.ParseTime = clock.GetElapsedTime();
+
+            LoadStyleResources(result);
+
+            result.TotalTime = totalClock.GetElapsedTime();
+
+            return true;
+        }
+
+        void    ResourceManager::LoadStyleResources(PreloadStats& result)
+        {
+            Clock           clock;
+
+            // Collect every resource referenced by the styles
+            std::vector<_PreloadRequest>    requests;
+            std::set<std::string>           imageNames;
+            std::set<std::string>           requested;
+
+            for (Styles::iterator it = mStyles.begin(); it != mStyles.end(); ++it)
+            {
+                StyleProperties& properties = it->second;
+                StyleProperties::const_iterator prop = properties.find("image");
+
+                if (prop != properties.end() && prop->second != "")
+                {
+                    std::string imageName = prop->second;
+
+                    if (imageName.substr(0, 4) == "sub:")
+                    {
+                        std::vector<std::string> rectElems;
+                        _GetElementsFromString(imageName.substr(4, imageName.length() - 4), ',', &rectElems);
+                        imageName = (rectElems.size() > 0) ? GetValue(rectElems[0], imageName) : "";
                     }
 
-                    if (nameStyle.size() == 0)
+                    imageNames.insert(prop->second);
+
+                    if (imageName != "" && mImages.find(imageName) == mImages.end() && requested.insert("i:" + imageName).second)
+                        requests.push_back(_PreloadRequest(imageName, imageName, false, 0.f));
+                }
+
+                prop = properties.find("font");
+
+                if (prop != properties.end() && prop->second != "")
+                {
+                    // Widgets request the font at the style text size, or at the size of its alias (see Label::LoadStyle())
+                    StyleProperties::const_iterator size = properties.find("textSize");
+                    const std::pair<std::string, unsigned int> font = ResolveFont(prop->second, (size != properties.end()) ? GetValue(size->second, 0.f) : 0.f);
+                    std::ostringstream key;
+
+                    key << "f:" << font.first << "@" << font.second;
+
+                    if (mFontCache.find(font) == mFontCache.end() && requested.insert(key.str()).second)
+                        requests.push_back(_PreloadRequest(font.first, font.first, true, static_cast<float>(font.second)));
+                }
+            }
+
+            // Read files in parallel : it doesn't need any rendering context. Each file is a chunk, reads are long
+            clock.Reset();
+
+            Widget::GetTaskPool()->ParallelFor(requests.size(), &_ReadPreloadFile, &requests, 1);
+
+            result.ReadTime = clock.GetElapsedTime();
+
+            // Create fonts and images on the current thread
+            float fontTime = 0.f;
+            float imageTime = 0.f;
+
+            for (std::vector<_PreloadRequest>::iterator it = requests.begin(); it != requests.end(); ++it)
+            {
+                clock.Reset();
+
+                if (it->Data.empty())
+                {
+                    std::cerr << "Could not preload \"" << it->Filename << "\"" << std::endl;
+                    ++result.FailureCount;
+                }
+                else if (it->IsFont)
+                {
+                    Font* font = new Font();
+
+                    // Fonts are cached by file and size, GetFont() finds them there
+                    if (font->LoadFromMemory(&it->Data[0], it->Data.size(), static_cast<unsigned int>(it->Size)))
                     {
-                        std::cerr << "Unable to parse style file. One of styles has no name." << std::endl;
-                        return false;
+                        Profiler::Count(Profiler::FONT_LOADS);
+                        mFontCache[std::make_pair(it->Filename, static_cast<unsigned int>(it->Size))] = font;
+                        mFontFiles[font] = it->Filename;
+                        ++result.FontCount;
                     }
-                    mStyles[nameStyle] = properties;
+                    else
+                    {
+                        delete font;
+                        ++result.FailureCount;
+                    }
+                    fontTime += clock.GetElapsedTime();
                 }
-                else if (t->ValueStr() == "resources")
+                else
                 {
-                    const TiXmlElement* cRes = t->FirstChildElement();
+                    Image* image = new Image();
 
-                    while (cRes)
+                    if (image->LoadFromMemory(&it->Data[0], it->Data.size()))
                     {
-                        if (cRes->ValueStr() == "font")
-                        {
-                            LoadFont(cRes->Attribute("name"), cRes->Attribute("src"), GetValue(cRes->Attribute("size"), 30.f));
-                        }
-                        else if (cRes->ValueStr() == "image")
-                        {
-                            LoadImage(cRes->Attribute("name"), cRes->Attribute("src"));
-                        }
-                        cRes = cRes->NextSiblingElement();
+                        mImages[it->ResId] = image;
+                        mImageFiles[it->ResId] = it->Filename;
+                        ++result.ImageCount;
                     }
+                    else
+                    {
+                        delete image;
+                        ++result.FailureCount;
+                    }
+                    imageTime += clock.GetElapsedTime();
                 }
-                t = t->NextSiblingElement();
+
+                // Release file content as soon as possible
+                std::vector<char>().swap(it->Data);
             }
 
-            return true;
+            // Resolve sub-rects, so widgets get their sprites from cache
+            clock.Reset();
+
+            for (std::set<std::string>::const_iterator it = imageNames.begin(); it != imageNames.end(); ++it)
+            {
+                GetImage(*it);
 
+                // Plain image names are cached in the sprites too
+                if (it->compare(0, 4, "sub:") == 0 && mSprites.find(*it) != mSprites.end())
+                    ++result.SubRectCount;
+            }
+
+            result.FontTime = fontTime;
+            result.ImageTime = imageTime + clock.GetElapsedTime();
+        }
+
+        bool    ResourceManager::SwitchTheme(const std::string& filename, PreloadStats* stats)
+        {
+            PreloadStats    localStats;
+            PreloadStats&   result = (stats) ? *stats : localStats;
+            Clock           totalClock;
+            Clock           clock;
+            Styles          newStyles;
+            StyleFile       newFile;
+            _StyleLoader    loader(*this, newStyles, newFile.Names);
+
+            result = PreloadStats();
+
+            if (!loader.Read(filename))
+                return false;
+
+            newFile.ModificationTime = _GetModificationTime(filename);
+
+            // Styles are compared on several threads, the current table is only read
+            _StyleDiff diff;
+            diff.Current = &mStyles;
+
+            for (Styles::iterator it = newStyles.begin(); it != newStyles.end(); ++it)
+                diff.Entries.push_back(it);
+            diff.Changed.resize(diff.Entries.size(), 0);
+
+            Widget::GetTaskPool()->ParallelFor(diff.Entries.size(), &_CompareStyle, &diff);
+
+            std::set<std::string> changed;
+
+            for (size_t i = 0; i < diff.Entries.size(); ++i)
+            {
+                if (diff.Changed[i])
+                {
+                    changed.insert(diff.Entries[i]->first);
+                    mStyles[diff.Entries[i]->first].swap(diff.Entries[i]->second);
+                }
+            }
+
+            _AddAliasUsers(mStyles, loader.Redefined, changed);
+
+            // The theme file is watched like the other style files
+            StyleFile& file = mStyleFiles[filename];
+            file.Names.insert(newFile.Names.begin(), newFile.Names.end());
+            file.ModificationTime = newFile.ModificationTime;
+
+            if (mHotReload)
+                WatchStyleFile(filename);
+
+            result.ParseTime = clock.GetElapsedTime();
+
+            LoadStyleResources(result);
+
+            clock.Reset();
+            result.WidgetCount = ApplyChangedStyles(changed);
+            result.StyleTime = clock.GetElapsedTime();
+            result.TotalTime = totalClock.GetElapsedTime();
+
+            return true;
         }
 
     }
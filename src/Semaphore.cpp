@@ -0,0 +1,122 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+    #include <climits>
+#else
+    #include <pthread.h>
+#endif
+
+#include <SFUI/Semaphore.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+#if defined(_WIN32)
+
+        /** Win32 semaphore */
+        struct Semaphore::Data
+        {
+            HANDLE              Handle;
+        };
+
+        Semaphore::Semaphore(unsigned int count)
+            :   mData(new Data())
+        {
+            mData->Handle = CreateSemaphore(NULL, static_cast<LONG>(count), LONG_MAX, NULL);
+        }
+
+        Semaphore::~Semaphore()
+        {
+            CloseHandle(mData->Handle);
+            delete mData;
+        }
+
+        void    Semaphore::Post()
+        {
+            ReleaseSemaphore(mData->Handle, 1, NULL);
+        }
+
+        void    Semaphore::Wait()
+        {
+            WaitForSingleObject(mData->Handle, INFINITE);
+        }
+
+#else
+
+        /** Count guarded by a mutex, waited on with a condition */
+        struct Semaphore::Data
+        {
+            pthread_cond_t      Condition;
+            unsigned int        Count;
+            pthread_mutex_t     Mutex;
+        };
+
+        Semaphore::Semaphore(unsigned int count)
+            :   mData(new Data())
+        {
+            mData->Count = count;
+            pthread_mutex_init(&mData->Mutex, NULL);
+            pthread_cond_init(&mData->Condition, NULL);
+        }
+
+        Semaphore::~Semaphore()
+        {
+            pthread_cond_destroy(&mData->Condition);
+            pthread_mutex_destroy(&mData->Mutex);
+            delete mData;
+        }
+
+        void    Semaphore::Post()
+        {
+            pthread_mutex_lock(&mData->Mutex);
+            ++mData->Count;
+            pthread_cond_signal(&mData->Condition);
+            pthread_mutex_unlock(&mData->Mutex);
+        }
+
+        void    Semaphore::Wait()
+        {
+            pthread_mutex_lock(&mData->Mutex);
+
+            // Wakes can be spurious : the count is checked again
+            while (mData->Count == 0)
+                pthread_cond_wait(&mData->Condition, &mData->Mutex);
+
+            --mData->Count;
+            pthread_mutex_unlock(&mData->Mutex);
+        }
+
+#endif
+
+    }
+
+}
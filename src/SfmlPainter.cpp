@@ -0,0 +1,207 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+
+#include <SFML/Graphics/RenderQueue.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/String.hpp>
+
+#include <SFUI/DistanceFieldFont.hpp>
+#include <SFUI/DistanceFieldText.hpp>
+#include <SFUI/NineSlice.hpp>
+#include <SFUI/Profiler.hpp>
+#include <SFUI/RectangleMesh.hpp>
+#include <SFUI/ResourceManager.hpp>
+#include <SFUI/SfmlPainter.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        void    SfmlPainter::Translation::Render(RenderTarget& target, RenderQueue&) const
+        {
+            target.Draw(*Inner);
+        }
+
+        SfmlPainter::SfmlPainter(RenderTarget& target, RenderQueue& queue, const Vector2f& origin)
+            :   mBase(origin),
+                mClips(),
+                mClipped(false),
+                mMesh(),
+                mQueue(queue),
+                mTarget(target),
+                mText(),
+                mTranslation(),
+                mUnitQuad()
+        {
+            mOrigin = origin;
+        }
+
+        SfmlPainter::~SfmlPainter()
+        {
+            if (mClipped)
+                Flush();
+        }
+
+        void    SfmlPainter::Draw(const Drawable& drawable)
+        {
+            Profiler::Count(Profiler::DRAW_CALLS);
+
+            if (mOrigin == mBase)
+            {
+                mTarget.Draw(drawable);
+                return;
+            }
+
+            // The drawable is drawn inside a drawable placed at the origin, relative to the target transformation
+            mTranslation.SetPosition(mOrigin - mBase);
+            mTranslation.Inner = &drawable;
+            mTarget.Draw(mTranslation);
+        }
+
+        void    SfmlPainter::DrawMesh(const RectangleMesh& mesh)
+        {
+            // The vertex colors are modulated by the mesh color and the opacity
+            mQueue.SetColor(ApplyOpacity(Color(255, 255, 255)));
+            Draw(mesh);
+        }
+
+        void    SfmlPainter::DrawNineSlice(const NineSlice& slice)
+        {
+            mQueue.SetColor(ApplyOpacity(slice.GetColor()));
+            Draw(slice);
+        }
+
+        void    SfmlPainter::DrawSprite(const Sprite& sprite)
+        {
+            mQueue.SetColor(ApplyOpacity(sprite.GetColor()));
+            Draw(sprite);
+        }
+
+        void    SfmlPainter::DrawString(const String& string)
+        {
+            const Font& font = string.GetFont();
+
+            // Scaled strings are drawn with the distance field of their font, when it is available
+            if (string.GetSize() != static_cast<float>(font.GetCharacterSize()))
+            {
+                const DistanceFieldFont* field = ResourceManager::Get()->GetDistanceField(font);
+
+                if (field)
+                {
+                    // The glyph quads of the strings drawn by this painter share the same memory
+                    mText.SetString(*field, string);
+
+                    mQueue.SetColor(ApplyOpacity(string.GetColor()));
+                    Draw(mText);
+                    return;
+                }
+            }
+
+            mQueue.SetColor(ApplyOpacity(string.GetColor()));
+            Draw(string);
+        }
+
+        void    SfmlPainter::FillRect(const FloatRect& rect, const Color& rectColor, float outline, const Color& rectOutlineColor)
+        {
+            const Color color = ApplyOpacity(rectColor);
+            const Color outlineColor = ApplyOpacity(rectOutlineColor);
+            const bool fill = (color.a > 0);
+            const bool border = (outline > 0.f && outlineColor.a > 0);
+
+            if (!fill && !border)
+                return;
+
+            if (!border)
+            {
+                // Fills share a white unit quad, transformed per rectangle and drawn with the fill color
+                mUnitQuad.SetPosition(rect.Left, rect.Top);
+                mUnitQuad.SetScale(rect.GetSize());
+                mQueue.SetColor(color);
+                Draw(mUnitQuad);
+                return;
+            }
+
+            // Only the visible parts of the mesh are sent to the queue
+            mMesh.SetPosition(rect.Left, rect.Top);
+            mMesh.SetGeometry(rect.GetSize(), outline);
+            mMesh.SetColors(color, outlineColor);
+            mQueue.SetColor(Color(255, 255, 255));
+            Draw(mMesh);
+        }
+
+        void    SfmlPainter::Flush()
+        {
+            if (mClips.empty())
+            {
+                mQueue.SetScissor(false);
+            }
+            else
+            {
+                const FloatRect& top = mClips.back();
+                mQueue.SetScissor(true, Vector2f(top.Left, mTarget.GetHeight() - top.Bottom), Vector2f(top.GetSize().x, top.GetSize().y));
+            }
+
+            Profiler::Count(Profiler::SCISSOR_FLUSHES);
+            mTarget.Flush();
+        }
+
+        void    SfmlPainter::PushClip(const FloatRect& rect)
+        {
+            FloatRect clip(mOrigin.x + rect.Left, mOrigin.y + rect.Top, mOrigin.x + rect.Right, mOrigin.y + rect.Bottom);
+
+            if (!mClips.empty())
+            {
+                const FloatRect& top = mClips.back();
+
+                clip.Left = std::max(clip.Left, top.Left);
+                clip.Top = std::max(clip.Top, top.Top);
+                clip.Right = std::max(clip.Left, std::min(clip.Right, top.Right));
+                clip.Bottom = std::max(clip.Top, std::min(clip.Bottom, top.Bottom));
+            }
+
+            // Queued drawings belong to the enclosing area
+            Flush();
+            mClips.push_back(clip);
+            mClipped = true;
+        }
+
+        void    SfmlPainter::PopClip()
+        {
+            Flush();
+
+            if (!mClips.empty())
+                mClips.pop_back();
+        }
+
+    }
+
+}
@@ -0,0 +1,470 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <SFUI/SkinFile.hpp>
+#include <SFUI/StyleReader.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** Skin file header, followed by the string entries, styles, properties, resources and string data */
+        struct _SkinHeader
+        {
+            char    Magic[4];
+            Uint32  ByteOrder;
+            Uint32  Version;
+            Uint32  StringCount;
+            Uint32  StyleCount;
+            Uint32  PropertyCount;
+            Uint32  ResourceCount;
+            Uint32  StringDataSize;
+        };
+
+        static const char   _SkinMagic[4] = { 'S', 'K', 'I', 'N' };
+        static const Uint32 _SkinByteOrder = 0x01020304;
+        static const Uint32 _SkinVersion = 1;
+
+
+        /** Helper storing each string once while compiling */
+        class _StringTable
+        {
+            public :
+
+                Uint32  Add(const std::string& str)
+                {
+                    std::map<std::string, Uint32>::iterator it = mIndices.find(str);
+
+                    if (it != mIndices.end())
+                        return it->second;
+
+                    Uint32 index = static_cast<Uint32>(mStrings.size());
+                    mIndices[str] = index;
+                    mStrings.push_back(str);
+                    return index;
+                }
+
+                const std::vector<std::string>&  GetStrings() const
+                {
+                    return mStrings;
+                }
+
+            private :
+
+                std::map<std::string, Uint32>   mIndices;
+
+                std::vector<std::string>        mStrings;
+        };
+
+        /** Style reader collecting styles and resource declarations for the compiler */
+        class _SkinReader : public StyleReader
+        {
+            public :
+
+                _SkinReader(std::map<std::string, StyleProperties>& styles, std::vector<SkinFile::Resource>& resources, _StringTable& strings)
+                    :   mStyles(styles),
+                        mResources(resources),
+                        mStrings(strings)
+                {}
+
+            protected :
+
+                virtual void    OnResource(const std::string& type, const std::string& name, const std::string& src, float size)
+                {
+                    SkinFile::Resource res;
+
+                    res.Type = (type == "font") ? SkinFile::FONT : SkinFile::IMAGE;
+                    res.Name = mStrings.Add(name);
+                    res.Source = mStrings.Add(src);
+                    res.Size = size;
+
+                    mResources.push_back(res);
+                }
+
+                virtual void    OnStyle(const std::string& name, StyleProperties& properties)
+                {
+                    mStyles[name].swap(properties);
+                }
+
+            private :
+
+                std::map<std::string, StyleProperties>& mStyles;
+
+                std::vector<SkinFile::Resource>&        mResources;
+
+                _StringTable&                           mStrings;
+        };
+
+        /** Check that count records fit in the file and move the offset after them */
+        static bool _Fits(size_t& offset, Uint32 count, size_t recordSize, size_t fileSize)
+        {
+            if (offset > fileSize || count > (fileSize - offset) / recordSize)
+                return false;
+
+            offset += count * recordSize;
+            return true;
+        }
+
+        template <typename T>
+        static void _Write(std::ofstream& file, const T& value)
+        {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+
+        SkinFile::SkinFile()
+            :   mData(0),
+                mSize(0),
+                mMapped(false),
+                mStringEntries(0),
+                mStyles(0),
+                mProperties(0),
+                mResources(0),
+                mStringData(0),
+                mStringCount(0),
+                mStyleCount(0),
+                mPropertyCount(0),
+                mResourceCount(0),
+                mStringDataSize(0)
+        {
+
+        }
+
+        SkinFile::~SkinFile()
+        {
+            Close();
+        }
+
+        bool    SkinFile::Compile(const std::string& xmlFile, const std::string& skinFile)
+        {
+            typedef std::map<std::string, StyleProperties> XmlStyles;
+
+            std::vector<Resource>   resources;
+            _StringTable            strings;
+            XmlStyles               styles;
+            _SkinReader             reader(styles, resources, strings);
+
+            if (!reader.Read(xmlFile))
+                return false;
+
+            // Styles and properties are written in std::map order (sorted by name)
+            std::vector<Style>              styleRecords;
+            std::vector<Property>           propertyRecords;
+            std::map<std::string, Uint32>   styleIndices;
+
+            for (XmlStyles::const_iterator it = styles.begin(); it != styles.end(); ++it)
+                styleIndices.insert(styleIndices.end(), std::make_pair(it->first, static_cast<Uint32>(styleIndices.size())));
+
+            for (XmlStyles::const_iterator it = styles.begin(); it != styles.end(); ++it)
+            {
+                Style style;
+
+                style.Name = strings.Add(it->first);
+                style.FirstProperty = static_cast<Uint32>(propertyRecords.size());
+                style.PropertyCount = static_cast<Uint32>(it->second.size());
+                style.Parent = NoIndex;
+
+                StyleProperties::const_iterator from = it->second.find("from");
+
+                if (from != it->second.end() && from->second != "")
+                {
+                    std::map<std::string, Uint32>::const_iterator parent = styleIndices.find(from->second);
+
+                    if (parent != styleIndices.end())
+                        style.Parent = parent->second;
+                    else
+                        std::cerr << "Style \"" << it->first << "\" inherits from unknown style \"" << from->second << "\"" << std::endl;
+                }
+
+                for (StyleProperties::const_iterator prop = it->second.begin(); prop != it->second.end(); ++prop)
+                {
+                    Property property;
+
+                    property.Key = strings.Add(prop->first);
+                    property.Value = strings.Add(prop->second);
+
+                    propertyRecords.push_back(property);
+                }
+
+                styleRecords.push_back(style);
+            }
+
+            // Build the string data (null-terminated strings, padded to 4 bytes)
+            const std::vector<std::string>& table = strings.GetStrings();
+            std::vector<Uint32> entries;
+            std::string data;
+
+            for (std::vector<std::string>::const_iterator it = table.begin(); it != table.end(); ++it)
+            {
+                entries.push_back(static_cast<Uint32>(data.size()));
+                entries.push_back(static_cast<Uint32>(it->size()));
+                data += *it;
+                data += '\0';
+            }
+
+            while (data.size() % 4)
+                data += '\0';
+
+            _SkinHeader header;
+
+            std::memcpy(header.Magic, _SkinMagic, sizeof(header.Magic));
+            header.ByteOrder = _SkinByteOrder;
+            header.Version = _SkinVersion;
+            header.StringCount = static_cast<Uint32>(table.size());
+            header.StyleCount = static_cast<Uint32>(styleRecords.size());
+            header.PropertyCount = static_cast<Uint32>(propertyRecords.size());
+            header.ResourceCount = static_cast<Uint32>(resources.size());
+            header.StringDataSize = static_cast<Uint32>(data.size());
+
+            std::ofstream out(skinFile.c_str(), std::ios::binary);
+
+            if (!out)
+            {
+                std::cerr << "Could not write \"" << skinFile << "\" skin file" << std::endl;
+                return false;
+            }
+
+            _Write(out, header);
+
+            for (std::vector<Uint32>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+                _Write(out, *it);
+            for (std::vector<Style>::const_iterator it = styleRecords.begin(); it != styleRecords.end(); ++it)
+                _Write(out, *it);
+            for (std::vector<Property>::const_iterator it = propertyRecords.begin(); it != propertyRecords.end(); ++it)
+                _Write(out, *it);
+            for (std::vector<Resource>::const_iterator it = resources.begin(); it != resources.end(); ++it)
+                _Write(out, *it);
+
+            out.write(data.data(), data.size());
+
+            return out.good();
+        }
+
+        bool    SkinFile::Open(const std::string& filename)
+        {
+            Close();
+
+#if !defined(_WIN32)
+            int fd = open(filename.c_str(), O_RDONLY);
+
+            if (fd >= 0)
+            {
+                struct stat info;
+
+                if (fstat(fd, &info) == 0 && info.st_size > 0)
+                {
+                    void* address = mmap(0, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+                    if (address != MAP_FAILED)
+                    {
+                        mData = static_cast<const char*>(address);
+                        mSize = static_cast<size_t>(info.st_size);
+                        mMapped = true;
+                    }
+                }
+                close(fd);
+            }
+#endif
+
+            // Fallback when mapping isn't available
+            if (!mData)
+            {
+                std::ifstream file(filename.c_str(), std::ios::binary);
+
+                if (!file)
+                    return false;
+
+                file.seekg(0, std::ios::end);
+                std::streamoff length = file.tellg();
+                file.seekg(0, std::ios::beg);
+
+                if (length <= 0)
+                    return false;
+
+                mBuffer.resize(static_cast<size_t>(length));
+                if (!file.read(&mBuffer[0], length))
+                {
+                    mBuffer.clear();
+                    return false;
+                }
+
+                mData = &mBuffer[0];
+                mSize = mBuffer.size();
+            }
+
+            if (!Validate())
+            {
+                std::cerr << "\"" << filename << "\" is not a valid skin file" << std::endl;
+                Close();
+                return false;
+            }
+            return true;
+        }
+
+        void    SkinFile::Close()
+        {
+#if !defined(_WIN32)
+            if (mMapped)
+                munmap(const_cast<char*>(mData), mSize);
+#endif
+            std::vector<char>().swap(mBuffer);
+
+            mData = 0;
+            mSize = 0;
+            mMapped = false;
+            mStringEntries = 0;
+            mStyles = 0;
+            mProperties = 0;
+            mResources = 0;
+            mStringData = 0;
+            mStringCount = mStyleCount = mPropertyCount = mResourceCount = mStringDataSize = 0;
+        }
+
+        bool    SkinFile::Validate()
+        {
+            if (mSize < sizeof(_SkinHeader))
+                return false;
+
+            const _SkinHeader* header = reinterpret_cast<const _SkinHeader*>(mData);
+
+            if (std::memcmp(header->Magic, _SkinMagic, sizeof(_SkinMagic)) != 0 ||
+                header->ByteOrder != _SkinByteOrder || header->Version != _SkinVersion)
+                return false;
+
+            size_t offset = sizeof(_SkinHeader);
+
+            if (!_Fits(offset, header->StringCount, 2 * sizeof(Uint32), mSize))
+                return false;
+            mStringEntries = reinterpret_cast<const Uint32*>(mData + sizeof(_SkinHeader));
+
+            mStyles = reinterpret_cast<const Style*>(mData + offset);
+            if (!_Fits(offset, header->StyleCount, sizeof(Style), mSize))
+                return false;
+
+            mProperties = reinterpret_cast<const Property*>(mData + offset);
+            if (!_Fits(offset, header->PropertyCount, sizeof(Property), mSize))
+                return false;
+
+            mResources = reinterpret_cast<const Resource*>(mData + offset);
+            if (!_Fits(offset, header->ResourceCount, sizeof(Resource), mSize))
+                return false;
+
+            mStringData = mData + offset;
+            if (!_Fits(offset, header->StringDataSize, 1, mSize))
+                return false;
+
+            mStringCount = header->StringCount;
+            mStyleCount = header->StyleCount;
+            mPropertyCount = header->PropertyCount;
+            mResourceCount = header->ResourceCount;
+            mStringDataSize = header->StringDataSize;
+
+            for (Uint32 i = 0; i < mStringCount; ++i)
+            {
+                Uint32 offset = mStringEntries[i * 2];
+                Uint32 length = mStringEntries[i * 2 + 1];
+
+                if (offset >= mStringDataSize || length >= mStringDataSize - offset || mStringData[offset + length] != '\0')
+                    return false;
+            }
+
+            for (Uint32 i = 0; i < mStyleCount; ++i)
+            {
+                const Style& style = mStyles[i];
+
+                if (style.Name >= mStringCount || style.FirstProperty > mPropertyCount || style.PropertyCount > mPropertyCount - style.FirstProperty ||
+                    (style.Parent != NoIndex && style.Parent >= mStyleCount))
+                    return false;
+            }
+
+            for (Uint32 i = 0; i < mPropertyCount; ++i)
+            {
+                if (mProperties[i].Key >= mStringCount || mProperties[i].Value >= mStringCount)
+                    return false;
+            }
+
+            for (Uint32 i = 0; i < mResourceCount; ++i)
+            {
+                const Resource& res = mResources[i];
+
+                if (res.Type > IMAGE || res.Name >= mStringCount || res.Source >= mStringCount)
+                    return false;
+            }
+
+            return true;
+        }
+
+        const char*     SkinFile::GetString(Uint32 index) const
+        {
+            return mStringData + mStringEntries[index * 2];
+        }
+
+        Uint32  SkinFile::GetStringLength(Uint32 index) const
+        {
+            return mStringEntries[index * 2 + 1];
+        }
+
+        Uint32  SkinFile::GetStyleCount() const
+        {
+            return mStyleCount;
+        }
+
+        const SkinFile::Style&  SkinFile::GetStyle(Uint32 index) const
+        {
+            return mStyles[index];
+        }
+
+        const SkinFile::Property&   SkinFile::GetProperty(Uint32 index) const
+        {
+            return mProperties[index];
+        }
+
+        Uint32  SkinFile::GetResourceCount() const
+        {
+            return mResourceCount;
+        }
+
+        const SkinFile::Resource&   SkinFile::GetResource(Uint32 index) const
+        {
+            return mResources[index];
+        }
+
+    }
+}
@@ -56,7 +56,7 @@ namespace sf
                 mSliderMovablePolicy.SetMovableY(true);
             }
 
-            LoadStyle(GetDefaultStyle());
+            LoadStyle(GetInitialStyle());
 
             Add(&mDecorator);
             Add(&mSlider);
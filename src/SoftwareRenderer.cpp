@@ -0,0 +1,375 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/String.hpp>
+
+#include <SFUI/DistanceFieldFont.hpp>
+#include <SFUI/NineSlice.hpp>
+#include <SFUI/RasterKernels.hpp>
+#include <SFUI/ResourceManager.hpp>
+#include <SFUI/SoftwareRenderer.hpp>
+#include <SFUI/Widget.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        static int  _Round(float value)
+        {
+            return static_cast<int>(std::floor(value + 0.5f));
+        }
+
+        SoftwareRenderer::SoftwareRenderer(unsigned int width, unsigned int height)
+            :   mHeight(height),
+                mPixels(width * height, 0),
+                mWidth(width)
+        {
+
+        }
+
+        void    SoftwareRenderer::Clear(const Color& color)
+        {
+            if (!mPixels.empty())
+                Raster::FillSpan(&mPixels[0], static_cast<unsigned int>(mPixels.size()), Raster::PackColor(color));
+        }
+
+        unsigned int    SoftwareRenderer::GetWidth() const
+        {
+            return mWidth;
+        }
+
+        unsigned int    SoftwareRenderer::GetHeight() const
+        {
+            return mHeight;
+        }
+
+        const Uint8*    SoftwareRenderer::GetPixels() const
+        {
+            return mPixels.empty() ? 0 : reinterpret_cast<const Uint8*>(&mPixels[0]);
+        }
+
+        bool    SoftwareRenderer::CopyToImage(Image& image) const
+        {
+            // sf::Image pixels have straight alpha
+            std::vector<Uint32> pixels(mPixels);
+
+            if (!pixels.empty())
+                Raster::Unpremultiply(&pixels[0], static_cast<unsigned int>(pixels.size()));
+
+            return image.LoadFromPixels(mWidth, mHeight, pixels.empty() ? 0 : reinterpret_cast<const Uint8*>(&pixels[0]));
+        }
+
+        bool    SoftwareRenderer::SaveToFile(const std::string& filename) const
+        {
+            Image image;
+
+            if (!CopyToImage(image))
+                return false;
+            return image.SaveToFile(filename);
+        }
+
+        void    SoftwareRenderer::Render(const Widget& widget)
+        {
+            SoftwarePainter painter(*this);
+
+            // The origin is the absolute position of the widget parent
+            painter.Translate(widget.GetAbsolutePosition() - widget.GetPosition());
+            widget.Paint(painter);
+        }
+
+        SoftwarePainter::SoftwarePainter(SoftwareRenderer& renderer)
+            :   mRenderer(renderer)
+        {
+            mClips.push_back(IntRect(0, 0, renderer.GetWidth(), renderer.GetHeight()));
+        }
+
+        IntRect     SoftwarePainter::ToPixels(const FloatRect& rect) const
+        {
+            return IntRect(_Round(mOrigin.x + rect.Left), _Round(mOrigin.y + rect.Top),
+                           _Round(mOrigin.x + rect.Right), _Round(mOrigin.y + rect.Bottom));
+        }
+
+        void    SoftwarePainter::FillPixels(int left, int top, int right, int bottom, Uint32 color)
+        {
+            const IntRect& clip = mClips.back();
+
+            left = std::max(left, clip.Left);
+            top = std::max(top, clip.Top);
+            right = std::min(right, clip.Right);
+            bottom = std::min(bottom, clip.Bottom);
+
+            if (left >= right || top >= bottom)
+                return;
+
+            const bool opaque = (reinterpret_cast<const Uint8*>(&color)[3] == 255);
+            Uint32* row = &mRenderer.mPixels[top * mRenderer.mWidth + left];
+
+            for (int y = top; y < bottom; ++y, row += mRenderer.mWidth)
+            {
+                if (opaque)
+                    Raster::FillSpan(row, right - left, color);
+                else
+                    Raster::BlendSpan(row, right - left, color);
+            }
+        }
+
+        void    SoftwarePainter::FillRect(const FloatRect& rect, const Color& color, float outline, const Color& outlineColor)
+        {
+            const IntRect pixels = ToPixels(rect);
+            const Color fill = ApplyOpacity(color);
+            const Color border = ApplyOpacity(outlineColor);
+
+            if (fill.a > 0)
+                FillPixels(pixels.Left, pixels.Top, pixels.Right, pixels.Bottom, Raster::PackColor(fill));
+
+            if (outline <= 0.f || border.a == 0)
+                return;
+
+            const int thickness = std::max(1, _Round(outline));
+            const Uint32 packed = Raster::PackColor(border);
+
+            // Top and bottom bands, then left and right bands between them
+            FillPixels(pixels.Left, pixels.Top, pixels.Right, std::min(pixels.Top + thickness, pixels.Bottom), packed);
+            FillPixels(pixels.Left, std::max(pixels.Bottom - thickness, pixels.Top + thickness), pixels.Right, pixels.Bottom, packed);
+            FillPixels(pixels.Left, pixels.Top + thickness, std::min(pixels.Left + thickness, pixels.Right), pixels.Bottom - thickness, packed);
+            FillPixels(std::max(pixels.Right - thickness, pixels.Left + thickness), pixels.Top + thickness, pixels.Right, pixels.Bottom - thickness, packed);
+        }
+
+        void    SoftwarePainter::BlitImage(const Image& image, IntRect source, const FloatRect& dest, const Color& tint, bool coverage)
+        {
+            const Color color = ApplyOpacity(tint);
+            const Uint8* pixels = image.GetPixelsPtr();
+            const IntRect target = ToPixels(dest);
+            const IntRect& clip = mClips.back();
+            const int imageWidth = static_cast<int>(image.GetWidth());
+            const int imageHeight = static_cast<int>(image.GetHeight());
+
+            source.Left = std::max(source.Left, 0);
+            source.Top = std::max(source.Top, 0);
+            source.Right = std::min(source.Right, imageWidth);
+            source.Bottom = std::min(source.Bottom, imageHeight);
+
+            const int sourceWidth = source.Right - source.Left;
+            const int sourceHeight = source.Bottom - source.Top;
+            const int targetWidth = target.Right - target.Left;
+            const int targetHeight = target.Bottom - target.Top;
+
+            if (!pixels || sourceWidth <= 0 || sourceHeight <= 0 || targetWidth <= 0 || targetHeight <= 0 || color.a == 0)
+                return;
+
+            const int left = std::max(target.Left, clip.Left);
+            const int right = std::min(target.Right, clip.Right);
+            const int top = std::max(target.Top, clip.Top);
+            const int bottom = std::min(target.Bottom, clip.Bottom);
+
+            if (left >= right || top >= bottom)
+                return;
+
+            // Nearest neighbour in 16.16 fixed point, sampled at the pixel centers
+            const Uint32 stepX = (static_cast<Uint32>(sourceWidth) << 16) / targetWidth;
+            const Uint32 stepY = (static_cast<Uint32>(sourceHeight) << 16) / targetHeight;
+            const Uint32 startX = (static_cast<Uint32>(source.Left) << 16) + stepX / 2 + (left - target.Left) * stepX;
+            Uint32 positionY = (static_cast<Uint32>(source.Top) << 16) + stepY / 2 + (top - target.Top) * stepY;
+
+            const unsigned int count = right - left;
+            const Uint32 packed = Raster::PackColor(color);
+
+            if (coverage)
+                mMask.resize(count);
+            else
+                mRow.resize(count);
+
+            for (int y = top; y < bottom; ++y, positionY += stepY)
+            {
+                const Uint32* sourceRow = reinterpret_cast<const Uint32*>(pixels) + (positionY >> 16) * imageWidth;
+                Uint32* row = &mRenderer.mPixels[y * mRenderer.mWidth + left];
+
+                if (coverage)
+                {
+                    Uint32 positionX = startX;
+
+                    for (unsigned int x = 0; x < count; ++x, positionX += stepX)
+                        mMask[x] = reinterpret_cast<const Uint8*>(sourceRow + (positionX >> 16))[3];
+
+                    Raster::BlendMask(row, &mMask[0], count, packed);
+                }
+                else
+                {
+                    Raster::ScalePixels(&mRow[0], sourceRow, count, startX, stepX);
+                    Raster::Premultiply(&mRow[0], count);
+                    Raster::BlendPixels(row, &mRow[0], count, packed);
+                }
+            }
+        }
+
+        void    SoftwarePainter::DrawNineSlice(const NineSlice& slice)
+        {
+            const Image* image = slice.GetImage();
+
+            if (!image)
+                return;
+
+            const Vector2f& position = slice.GetPosition();
+
+            for (unsigned int row = 0; row < 3; ++row)
+            {
+                for (unsigned int column = 0; column < 3; ++column)
+                {
+                    const FloatRect& dest = slice.GetDestRect(column, row);
+
+                    BlitImage(*image, slice.GetSourceRect(column, row),
+                              FloatRect(position.x + dest.Left, position.y + dest.Top, position.x + dest.Right, position.y + dest.Bottom),
+                              slice.GetColor(), false);
+                }
+            }
+        }
+
+        void    SoftwarePainter::DrawSprite(const Sprite& sprite)
+        {
+            const Image* image = sprite.GetImage();
+
+            if (!image)
+                return;
+
+            IntRect source = sprite.GetSubRect();
+
+            if (source.Right <= source.Left || source.Bottom <= source.Top)
+                source = IntRect(0, 0, image->GetWidth(), image->GetHeight());
+
+            const Vector2f& position = sprite.GetPosition();
+            const Vector2f size = sprite.GetSize();
+
+            BlitImage(*image, source, FloatRect(position.x, position.y, position.x + size.x, position.y + size.y), sprite.GetColor(), false);
+        }
+
+        void    SoftwarePainter::DrawString(const String& string)
+        {
+            const Font& font = string.GetFont();
+            const Image& atlas = font.GetImage();
+            const float charSize = static_cast<float>(font.GetCharacterSize());
+
+            if (charSize <= 0.f)
+                return;
+
+            // Scaled strings are drawn with the distance field of their font, when it is available
+            const DistanceFieldFont* field = (string.GetSize() != charSize) ? ResourceManager::Get()->GetDistanceField(font) : 0;
+
+            if (field)
+            {
+                mText.SetString(*field, string);
+
+                const std::vector<DistanceFieldText::Quad>& quads = mText.GetQuads();
+                const Vector2f& position = mText.GetPosition();
+
+                for (unsigned int i = 0; i < quads.size(); ++i)
+                {
+                    const FloatRect& dest = quads[i].Dest;
+
+                    BlitImage(*mText.GetImage(), quads[i].Source,
+                              FloatRect(position.x + dest.Left, position.y + dest.Top, position.x + dest.Right, position.y + dest.Bottom),
+                              string.GetColor(), true);
+                }
+                return;
+            }
+
+            const Unicode::UTF32String& text = string.GetText();
+            const Vector2f& position = string.GetPosition();
+            const float factor = string.GetSize() / charSize;
+            const float atlasWidth = static_cast<float>(atlas.GetWidth());
+            const float atlasHeight = static_cast<float>(atlas.GetHeight());
+
+            // Same layout as sf::String : the first baseline is one character size below the top
+            float x = 0.f;
+            float y = charSize;
+
+            for (Unicode::UTF32String::const_iterator it = text.begin(); it != text.end(); ++it)
+            {
+                const Uint32 c = *it;
+
+                if (c == L'\n')
+                {
+                    x = 0.f;
+                    y += charSize;
+                    continue;
+                }
+                else if (c == L' ')
+                {
+                    x += font.GetGlyph(L' ').Advance;
+                    continue;
+                }
+                else if (c == L'\t')
+                {
+                    x += font.GetGlyph(L' ').Advance * 4;
+                    continue;
+                }
+
+                const Glyph& glyph = font.GetGlyph(c);
+                const IntRect& rect = glyph.Rectangle;
+                const FloatRect& coords = glyph.TexCoords;
+
+                IntRect source(_Round(coords.Left * atlasWidth), _Round(coords.Top * atlasHeight),
+                               _Round(coords.Right * atlasWidth), _Round(coords.Bottom * atlasHeight));
+
+                FloatRect dest(position.x + (x + rect.Left) * factor, position.y + (y + rect.Top) * factor,
+                               position.x + (x + rect.Right) * factor, position.y + (y + rect.Bottom) * factor);
+
+                // Glyphs are white, their alpha is the coverage
+                BlitImage(atlas, source, dest, string.GetColor(), true);
+
+                x += glyph.Advance;
+            }
+        }
+
+        void    SoftwarePainter::PushClip(const FloatRect& rect)
+        {
+            const IntRect& clip = mClips.back();
+            IntRect pixels = ToPixels(rect);
+
+            pixels.Left = std::max(pixels.Left, clip.Left);
+            pixels.Top = std::max(pixels.Top, clip.Top);
+            pixels.Right = std::max(pixels.Left, std::min(pixels.Right, clip.Right));
+            pixels.Bottom = std::max(pixels.Top, std::min(pixels.Bottom, clip.Bottom));
+
+            mClips.push_back(pixels);
+        }
+
+        void    SoftwarePainter::PopClip()
+        {
+            if (mClips.size() > 1)
+                mClips.pop_back();
+        }
+
+    }
+
+}
@@ -0,0 +1,227 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <SFUI/StyleReader.hpp>
+
+#include <TinyXML/tinyxml.h>
+
+namespace sf
+{
+    namespace ui
+    {
+        static const char*  _SkipBlock(const char* p, const char* end)
+        {
+            const char* found = std::strstr(p, end);
+            return (found) ? found + std::strlen(end) : 0;
+        }
+
+        /** Convert \r\n and lone \r line ends to \n, like TiXmlDocument::LoadFile() */
+        static void _NormalizeLineEnds(std::string& buffer)
+        {
+            std::string::size_type out = 0;
+
+            for (std::string::size_type in = 0; in < buffer.size(); ++in)
+            {
+                if (buffer[in] == '\r')
+                {
+                    buffer[out++] = '\n';
+                    if (in + 1 < buffer.size() && buffer[in + 1] == '\n')
+                        ++in;
+                }
+                else
+                {
+                    buffer[out++] = buffer[in];
+                }
+            }
+            buffer.resize(out);
+        }
+
+        static int  _GetLine(const std::string& buffer, const char* p)
+        {
+            int line = 1;
+
+            for (const char* c = buffer.c_str(); c < p; ++c)
+            {
+                if (*c == '\n')
+                    ++line;
+            }
+            return line;
+        }
+
+        bool    StyleReader::Read(const std::string& filename)
+        {
+            std::ifstream file(filename.c_str(), std::ios::binary);
+
+            if (!file)
+            {
+                std::cerr << "Could not load \"" << filename << "\" style file" << std::endl;
+                return false;
+            }
+
+            // The raw text is the only thing kept for the whole file
+            std::string buffer;
+
+            file.seekg(0, std::ios::end);
+            std::streamoff length = file.tellg();
+            file.seekg(0, std::ios::beg);
+
+            if (length > 0)
+            {
+                buffer.resize(static_cast<size_t>(length));
+                file.read(&buffer[0], length);
+                buffer.resize(static_cast<size_t>(file.gcount()));
+            }
+
+            // Attribute values and texts are read in place, they must not keep \r characters
+            _NormalizeLineEnds(buffer);
+
+            TiXmlEncoding encoding = TIXML_ENCODING_UNKNOWN;
+            const char* p = buffer.c_str();
+            bool hasElement = false;
+
+            // Microsoft UTF-8 lead bytes
+            if (buffer.size() >= 3 && buffer.compare(0, 3, "\xEF\xBB\xBF") == 0)
+            {
+                encoding = TIXML_ENCODING_UTF8;
+                p += 3;
+            }
+
+            while (p && *p)
+            {
+                while (*p && std::isspace(static_cast<unsigned char>(*p)))
+                    ++p;
+
+                if (!*p)
+                    break;
+
+                if (std::strncmp(p, "<!--", 4) == 0)
+                {
+                    p = _SkipBlock(p + 4, "-->");
+                }
+                else if (std::strncmp(p, "<?xml", 5) == 0)
+                {
+                    TiXmlDeclaration declaration;
+                    p = declaration.Parse(p, 0, encoding);
+
+                    if (encoding == TIXML_ENCODING_UNKNOWN)
+                    {
+                        std::string enc = declaration.Encoding();
+                        encoding = (enc == "" || enc == "UTF-8" || enc == "utf-8" || enc == "UTF8") ? TIXML_ENCODING_UTF8 : TIXML_ENCODING_LEGACY;
+                    }
+                }
+                else if (std::strncmp(p, "<?", 2) == 0)
+                {
+                    p = _SkipBlock(p + 2, "?>");
+                }
+                else if (std::strncmp(p, "<!", 2) == 0)
+                {
+                    p = _SkipBlock(p + 2, ">");
+                }
+                else if (*p == '<')
+                {
+                    const char* start = p;
+
+                    // Only this element lives in memory, it is released at the end of the iteration
+                    TiXmlElement element("");
+                    p = element.Parse(p, 0, encoding);
+
+                    if (!p)
+                    {
+                        std::cerr << "Unable to parse style file \"" << filename << "\" (line " << _GetLine(buffer, start) << ")" << std::endl;
+                        return false;
+                    }
+
+                    hasElement = true;
+
+                    if (element.ValueStr() == "style")
+                    {
+                        StyleProperties properties;
+                        std::string nameStyle;
+
+                        for (const TiXmlAttribute* attr = element.FirstAttribute(); attr; attr = attr->Next())
+                        {
+                            if (std::strcmp(attr->Name(), "name") == 0)
+                                nameStyle = attr->ValueStr();
+                            else
+                                properties[attr->Name()] = attr->ValueStr();
+                        }
+
+                        if (nameStyle.size() == 0)
+                        {
+                            std::cerr << "Unable to parse style file. One of styles has no name (line " << _GetLine(buffer, start) << ")." << std::endl;
+                            return false;
+                        }
+
+                        OnStyle(nameStyle, properties);
+                    }
+                    else if (element.ValueStr() == "resources")
+                    {
+                        for (const TiXmlElement* cRes = element.FirstChildElement(); cRes; cRes = cRes->NextSiblingElement())
+                        {
+                            const char* name = cRes->Attribute("name");
+                            const char* src = cRes->Attribute("src");
+                            double size = 30.0;
+
+                            if (!name || !src)
+                                continue;
+
+                            cRes->QueryDoubleAttribute("size", &size);
+
+                            if (cRes->ValueStr() == "font" || cRes->ValueStr() == "image")
+                                OnResource(cRes->ValueStr(), name, src, static_cast<float>(size));
+                        }
+                    }
+                }
+                else
+                {
+                    std::cerr << "Unable to parse style file \"" << filename << "\" (line " << _GetLine(buffer, p) << ")" << std::endl;
+                    return false;
+                }
+            }
+
+            if (!p)
+            {
+                std::cerr << "Unable to parse style file \"" << filename << "\" : unterminated block" << std::endl;
+                return false;
+            }
+
+            if (!hasElement)
+            {
+                std::cerr << "Unable to parse style file" << std::endl;
+                return false;
+            }
+
+            return true;
+        }
+    }
+}
@@ -0,0 +1,320 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+
+#include <SFUI/TaskPool.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        /** Indices of a ParallelFor() call, shared by the threads taking part in it */
+        struct TaskPool::Pass
+        {
+            void            (*Function)(void* userData, std::size_t index);
+            void*           UserData;
+            std::size_t     ChunkSize;
+            std::size_t     Count;
+            std::size_t     Next;
+            std::size_t     Done;
+            unsigned int    References;
+            Mutex           Access;
+            Semaphore       Finished;
+        };
+
+        /** A worker taking part in a pass */
+        class TaskPool::PassTask : public Task
+        {
+            public :
+
+                explicit PassTask(Pass* pass)
+                    :   mPass(pass)
+                {
+
+                }
+
+                /** The pass is released even if the task never ran */
+                virtual ~PassTask()
+                {
+                    TaskPool::ReleasePass(mPass);
+                }
+
+                virtual void    Run()
+                {
+                    TaskPool::RunPass(mPass);
+                }
+
+            private :
+
+                Pass*           mPass;
+        };
+
+        static unsigned int     _GetProcessorCount()
+        {
+#if defined(_WIN32)
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return static_cast<unsigned int>(info.dwNumberOfProcessors);
+#elif defined(_SC_NPROCESSORS_ONLN)
+            long count = sysconf(_SC_NPROCESSORS_ONLN);
+            return (count > 0) ? static_cast<unsigned int>(count) : 1;
+#else
+            return 1;
+#endif
+        }
+
+        TaskPool::TaskPool(unsigned int threadCount)
+            :   mPendingCount(0),
+                mQueued(0),
+                mStopping(false)
+        {
+            if (threadCount == 0)
+                threadCount = std::min(8u, std::max(1u, _GetProcessorCount() - 1));
+
+            for (unsigned int i = 0; i < threadCount; ++i)
+            {
+                mThreads.push_back(new Thread(&TaskPool::RunWorker, this));
+                mThreads.back()->Launch();
+            }
+        }
+
+        TaskPool::~TaskPool()
+        {
+            {
+                Lock lock(mTasksAccess);
+                mStopping = true;
+
+                // Pass tasks still queued belong to a ParallelFor() call on another thread. The calling thread
+                // runs the chunks no worker took, so deleting them only releases their reference to the pass
+                for (std::deque<Task*>::iterator it = mPassTasks.begin(); it != mPassTasks.end(); ++it)
+                    delete *it;
+                mPassTasks.clear();
+            }
+
+            // Each worker wakes up once, sees the pool stopping and leaves
+            for (unsigned int i = 0; i < mThreads.size(); ++i)
+                mQueued.Post();
+
+            for (unsigned int i = 0; i < mThreads.size(); ++i)
+            {
+                mThreads[i]->Wait();
+                delete mThreads[i];
+            }
+
+            for (std::deque<Task*>::iterator it = mTasks.begin(); it != mTasks.end(); ++it)
+                delete *it;
+
+            for (std::vector<Task*>::iterator it = mCompleted.begin(); it != mCompleted.end(); ++it)
+                delete *it;
+        }
+
+        unsigned int    TaskPool::Dispatch()
+        {
+            std::vector<Task*> completed;
+            {
+                Lock lock(mCompletedAccess);
+                completed.swap(mCompleted);
+            }
+
+            for (std::vector<Task*>::iterator it = completed.begin(); it != completed.end(); ++it)
+            {
+                (*it)->OnComplete();
+                delete *it;
+            }
+
+            mPendingCount -= static_cast<unsigned int>(completed.size());
+
+            return static_cast<unsigned int>(completed.size());
+        }
+
+        unsigned int    TaskPool::GetPendingCount() const
+        {
+            return mPendingCount;
+        }
+
+        unsigned int    TaskPool::GetThreadCount() const
+        {
+            return static_cast<unsigned int>(mThreads.size());
+        }
+
+        void    TaskPool::ParallelFor(std::size_t count, void (*function)(void*, std::size_t), void* userData, std::size_t chunkSize)
+        {
+            if (count == 0)
+                return;
+
+            chunkSize = std::max<std::size_t>(1, chunkSize);
+
+            // Workers are only asked to help when there are enough chunks
+            const std::size_t helperCount = std::min<std::size_t>(mThreads.size(), count / (chunkSize * 2));
+
+            Pass* pass = new Pass();
+            pass->Function = function;
+            pass->UserData = userData;
+            pass->ChunkSize = chunkSize;
+            pass->Count = count;
+            pass->Next = 0;
+            pass->Done = 0;
+            pass->References = static_cast<unsigned int>(helperCount) + 1;
+
+            if (helperCount > 0)
+            {
+                {
+                    Lock lock(mTasksAccess);
+
+                    for (std::size_t i = 0; i < helperCount; ++i)
+                        mPassTasks.push_back(new PassTask(pass));
+                }
+
+                for (std::size_t i = 0; i < helperCount; ++i)
+                    mQueued.Post();
+            }
+
+            // The calling thread takes part in the pass, then waits for the chunks run by the workers
+            RunPass(pass);
+            pass->Finished.Wait();
+            ReleasePass(pass);
+        }
+
+        void    TaskPool::ReleasePass(Pass* pass)
+        {
+            bool last = false;
+            {
+                Lock lock(pass->Access);
+                last = (--pass->References == 0);
+            }
+
+            // Workers which started late hold the pass until they found nothing left to do
+            if (last)
+                delete pass;
+        }
+
+        void    TaskPool::RunPass(Pass* pass)
+        {
+            std::size_t first = 0;
+            std::size_t last = 0;
+
+            while (true)
+            {
+                {
+                    Lock lock(pass->Access);
+
+                    // The chunk run before is accounted for, the thread finishing the last one wakes up the caller
+                    pass->Done += last - first;
+
+                    if (last > first && pass->Done == pass->Count)
+                        pass->Finished.Post();
+
+                    if (pass->Next >= pass->Count)
+                        return;
+
+                    first = pass->Next;
+                    last = std::min(pass->Count, first + pass->ChunkSize);
+                    pass->Next = last;
+                }
+
+                for (std::size_t i = first; i < last; ++i)
+                    pass->Function(pass->UserData, i);
+            }
+        }
+
+        void    TaskPool::RunWorker(void* userData)
+        {
+            TaskPool* pool = static_cast<TaskPool*>(userData);
+
+            while (true)
+            {
+                pool->mQueued.Wait();
+
+                Task* task = 0;
+                bool passTask = false;
+                {
+                    Lock lock(pool->mTasksAccess);
+
+                    if (pool->mStopping)
+                        return;
+
+                    // Pass tasks first : a thread is waiting for them
+                    if (!pool->mPassTasks.empty())
+                    {
+                        task = pool->mPassTasks.front();
+                        pool->mPassTasks.pop_front();
+                        passTask = true;
+                    }
+                    else if (!pool->mTasks.empty())
+                    {
+                        task = pool->mTasks.front();
+                        pool->mTasks.pop_front();
+                    }
+                }
+
+                if (!task)
+                    continue;
+
+                task->Run();
+
+                // Pass tasks are internal, they are not completed by Dispatch()
+                if (passTask)
+                {
+                    delete task;
+                    continue;
+                }
+
+                Lock lock(pool->mCompletedAccess);
+                pool->mCompleted.push_back(task);
+            }
+        }
+
+        void    TaskPool::Submit(Task* task)
+        {
+            if (!task)
+                return;
+
+            ++mPendingCount;
+
+            {
+                Lock lock(mTasksAccess);
+                mTasks.push_back(task);
+            }
+
+            mQueued.Post();
+        }
+
+    }
+
+}
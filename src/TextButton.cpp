@@ -44,7 +44,7 @@ namespace sf
             Add(&mCaption);
 
             SetDefaultStyle("BI_TextButton");
-            LoadStyle(GetDefaultStyle());
+            LoadStyle(GetInitialStyle());
         }
 
         void    TextButton::LoadStyle(const std::string& nameStyle)
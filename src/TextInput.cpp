@@ -26,10 +26,12 @@
 
 */
 
+#include <algorithm>
+
 #include <SFML/Window/Event.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
-#include <SFML/Graphics/Shape.hpp>
 
+#include <SFUI/Painter.hpp>
 #include <SFUI/TextInput.hpp>
 
 namespace sf
@@ -50,7 +52,7 @@ namespace sf
                 mSelectionStart(0)
         {
             SetDefaultStyle("BI_TextInput");
-            LoadStyle(GetDefaultStyle());
+            LoadStyle(GetInitialStyle());
 
             Add(&mString);
             AdjustRect();
@@ -89,9 +91,13 @@ namespace sf
             SetSelectionColor(rm->GetColorValue(properties["selectionColor"], GetSelectionColor()));
 
             SetTextColor(rm->GetColorValue(properties["textColor"], GetTextColor()));
-            SetTextSize(rm->GetValue(properties["textSize"], GetTextSize()));
+            // The font is requested at the style text size, or at the size of its alias
+            const float textSize = rm->GetValue(properties["textSize"], 0.f);
+
+            if (textSize > 0.f)
+                SetTextSize(textSize);
 
-            Font* newFont = rm->GetFont(properties["font"], GetTextSize());
+            Font* newFont = rm->GetFont(properties["font"], textSize);
             if (newFont)
             {
                 SetFont(*newFont);
@@ -373,9 +379,9 @@ namespace sf
             mString.SetX(mStringOffset - mCursorOffset);
         }
 
-        void    TextInput::OnPaint(RenderTarget& target, RenderQueue& queue) const
+        void    TextInput::OnPaint(Painter& painter) const
         {
-            Widget::OnPaint(target, queue);
+            Widget::OnPaint(painter);
 
             // Draws the cursor with real position
             if (HasFocus())
@@ -388,8 +394,7 @@ namespace sf
                 realPos.x = realPos.x - mCursorOffset + mStringOffset;
                 realPos.y = GetHeight() - 2.f;
 
-                queue.SetColor(GetTextColor());
-                target.Draw(Shape::Rectangle(realPos.x, yPos, realPos.x + 1, realPos.y, GetTextColor()));
+                painter.FillRect(FloatRect(realPos.x, yPos, realPos.x + 1, realPos.y), GetTextColor());
 
                 // Draws the current selection
                 if (mSelectionStart != mCursorPosition)
@@ -398,19 +403,7 @@ namespace sf
                     selectionPos.x = (selectionPos.x - mCursorOffset + mStringOffset);
                     selectionPos.y = (selectionPos.y - mCursorOffset + mStringOffset);
 
-                    queue.SetColor(mSelectionColor);
-                    queue.SetTexture(0);
-
-                    queue.BeginBatch();
-                    {
-                        queue.AddVertex(selectionPos.x, yPos);
-                        queue.AddVertex(selectionPos.y, yPos);
-                        queue.AddVertex(selectionPos.y, realPos.y);
-                        queue.AddVertex(selectionPos.x, realPos.y);
-
-                        queue.AddTriangle(0, 1, 3);
-                        queue.AddTriangle(3, 1, 2);
-                    }
+                    painter.FillRect(FloatRect(std::min(selectionPos.x, selectionPos.y), yPos, std::max(selectionPos.x, selectionPos.y), realPos.y), mSelectionColor);
                 }
 
             }
@@ -25,15 +25,20 @@
     SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
-#include <SFML/Graphics/Shape.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderQueue.hpp>
 
+#include <SFUI/Animator.hpp>
+#include <SFUI/Profiler.hpp>
+#include <SFUI/SfmlPainter.hpp>
+#include <SFUI/TaskPool.hpp>
 #include <SFUI/Widget.hpp>
+#include <SFUI/WidgetPool.hpp>
 #include <SFUI/MouseListener.hpp>
 #include <SFUI/KeyListener.hpp>
 
 #include <algorithm>
+#include <limits>
 
 namespace sf
 {
@@ -41,25 +46,82 @@ namespace sf
     {
         Widget*     Widget::mFocusedWidget = 0;
         Widget*     Widget::mHoveredWidget = 0;
+        const void* Widget::mInitialMemory = 0;
+        bool        Widget::mInitialPending = false;
+        std::string Widget::mInitialStyle;
+        Widget*     Widget::mLastHovered = 0;
+        TaskPool*   Widget::mTaskPool = 0;
+        Animator*   Widget::mAnimator = 0;
+
+        // Space between the z keys of two brothers, for the widgets inserted between them
+        static const Uint32     _zKeyGap = 1024;
 
         Widget::Widget(Vector2f pos, Vector2f size)
             :   Drawable(pos),
-                mSize(size),
-                mEnabled(true),
-                mVisible(true),
-                mFocusable(true),
-                mDefaultStyle("BI_Widget"),
                 mAlign(Align::NONE),
                 mAlignOffset(0.f, 0.f),
                 mBorderColor(Color(0,0,0,0)),
-                mUseScissor(false)
+                mChildrenChanged(false),
+                mDefaultStyle("BI_Widget"),
+                mEnabled(true),
+                mFirstChild(0),
+                mFocusable(true),
+                mLastChild(0),
+                mChildLayoutValid(false),
+                mLayoutValid(false),
+                mMeasuredSize(size),
+                mMeasureValid(false),
+                mMesh(Vector2f(0.f, 0.f)),
+                mNextSibling(0),
+                mOpacity(1.f),
+                mPreferredSize(size),
+                mPrevSibling(0),
+                mSize(size),
+                mUseScissor(false),
+                mVisible(true),
+                mZKey(0)
         {
             mParent = 0;
         }
 
         Widget::~Widget()
         {
+            if (mParent)
+            {
+                mParent->Unlink(this);
+                mParent->OnChildRemoved(this);
+            }
 
+            for (Widget* child = mFirstChild; child; )
+            {
+                Widget* next = child->mNextSibling;
+
+                child->mParent = child->mPrevSibling = child->mNextSibling = 0;
+                child = next;
+            }
+
+            if (Widget::mFocusedWidget == this)
+                Widget::mFocusedWidget = 0;
+            if (Widget::mHoveredWidget == this)
+                Widget::mHoveredWidget = 0;
+            if (Widget::mLastHovered == this)
+                Widget::mLastHovered = 0;
+
+            Profiler::Forget(this);
+
+            if (Widget::mAnimator)
+                Widget::mAnimator->Stop(*this);
+
+            // The ResourceManager may already be killed by the GuiRenderer
+            if (ResourceManager::mInstance)
+                ResourceManager::mInstance->SetStyleUser(this, mStyle, "");
+        }
+
+        void    Widget::SetInitialStyle(const std::string& style)
+        {
+            mInitialStyle = style;
+            mInitialPending = !style.empty();
+            mInitialMemory = 0;
         }
 
         void    Widget::SetDefaultStyle(const std::string& style)
@@ -72,8 +134,20 @@ namespace sf
             return mDefaultStyle;
         }
 
+        const std::string&  Widget::GetInitialStyle() const
+        {
+            // Only the widget allocated after SetInitialStyle() uses it, not the widgets it is made of
+            return (mInitialMemory == this) ? mInitialStyle : mDefaultStyle;
+        }
+
+        const std::string&  Widget::GetCurrentStyle() const
+        {
+            return mStyle;
+        }
+
         void    Widget::LoadStyle(const std::string& style)
         {
+            ProfileScope scope(Profiler::LOAD_STYLE, this);
             ResourceManager* rm = ResourceManager::Get();
 
             StyleProperties& properties = rm->GetStyle(style);
@@ -122,9 +196,14 @@ namespace sf
 
             SetEnabled(rm->GetValue(properties["enabled"], IsEnabled()));
             SetVisible(rm->GetValue(properties["visible"], IsVisible()));
+            SetOpacity(rm->GetValue(properties["opacity"], GetOpacity()));
             SetFocusable(rm->GetValue(properties["focusable"], IsFocusable()));
 
             UpdatePosition();
+
+            // Inherited styles are loaded first, so the outermost style is the one registered
+            rm->SetStyleUser(this, mStyle, style);
+            mStyle = style;
         }
 
         void    Widget::SetBorderColor(const Color& borderColor)
@@ -142,6 +221,8 @@ namespace sf
         {
             mSize.x = size.x;
             mSize.y = size.y;
+            mPreferredSize = mSize;
+            InvalidateMeasure();
             OnChange(Widget::SIZE);
         }
 
@@ -153,15 +234,36 @@ namespace sf
         void    Widget::SetWidth(float width)
         {
             mSize.x = width;
+            mPreferredSize.x = width;
+            InvalidateMeasure();
             OnChange(Widget::SIZE);
         }
 
         void    Widget::SetHeight(float height)
         {
             mSize.y = height;
+            mPreferredSize.y = height;
+            InvalidateMeasure();
+            OnChange(Widget::SIZE);
+        }
+
+        void    Widget::SetLayoutRect(const FloatRect& rect)
+        {
+            SetPosition(rect.Left, rect.Top);
+
+            if (mSize.x == rect.GetSize().x && mSize.y == rect.GetSize().y)
+                return;
+
+            mSize = rect.GetSize();
             OnChange(Widget::SIZE);
         }
 
+        void    Widget::SetOpacity(float opacity)
+        {
+            mOpacity = std::min(1.f, std::max(0.f, opacity));
+            OnChange(Widget::OPACITY);
+        }
+
         const Color&        Widget::GetBorderColor() const
         {
             return mBorderColor;
@@ -172,6 +274,20 @@ namespace sf
             return mSize;
         }
 
+        Animator*   Widget::GetAnimator()
+        {
+            return mAnimator;
+        }
+
+        TaskPool*   Widget::GetTaskPool()
+        {
+            // GUIs which never run background jobs don't start the worker threads
+            if (!mTaskPool)
+                mTaskPool = new TaskPool();
+
+            return mTaskPool;
+        }
+
         float   Widget::GetWidth() const
         {
             return mSize.x;
@@ -224,6 +340,11 @@ namespace sf
         void    Widget::SetVisible(bool visible)
         {
             mVisible = visible;
+
+            // Layouts skip the hidden children
+            if (mParent)
+                mParent->InvalidateMeasure();
+
             OnChange(Widget::VISIBLE);
         }
 
@@ -267,26 +388,140 @@ namespace sf
 
         const Widgets& Widget::GetChildren() const
         {
+            if (mChildrenChanged)
+            {
+                mChildren.clear();
+
+                for (Widget* child = mFirstChild; child; child = child->mNextSibling)
+                    mChildren.push_back(child);
+
+                mChildrenChanged = false;
+            }
             return mChildren;
         }
 
+        Widget*     Widget::GetFirstChild() const
+        {
+            return mFirstChild;
+        }
+
+        Widget*     Widget::GetLastChild() const
+        {
+            return mLastChild;
+        }
+
+        const Vector2f&     Widget::GetMeasuredSize() const
+        {
+            if (!mMeasureValid)
+            {
+                mMeasuredSize = OnMeasure();
+                mMeasureValid = true;
+            }
+
+            return mMeasuredSize;
+        }
+
+        const Vector2f&     Widget::GetPreferredSize() const
+        {
+            return mPreferredSize;
+        }
+
+        void    Widget::InvalidateLayout()
+        {
+            mLayoutValid = false;
+
+            // The layout pass reaches the widget through the parents with an invalid child
+            for (Widget* widget = mParent; widget && widget->mChildLayoutValid; widget = widget->mParent)
+                widget->mChildLayoutValid = false;
+        }
+
+        void    Widget::InvalidateMeasure()
+        {
+            // The parents of an invalid widget are invalid already, unless they don't depend on it
+            for (Widget* widget = this; widget && (widget->mMeasureValid || widget->mLayoutValid); widget = widget->mParent)
+            {
+                widget->mMeasureValid = false;
+                widget->mLayoutValid = false;
+            }
+        }
+
+        Widget*     Widget::GetNextSibling() const
+        {
+            return mNextSibling;
+        }
+
+        float   Widget::GetOpacity() const
+        {
+            return mOpacity;
+        }
+
+        Widget*     Widget::GetPreviousSibling() const
+        {
+            return mPrevSibling;
+        }
+
         Widget*     Widget::GetParent() const
         {
             return mParent;
         }
 
-        Widgets::iterator    Widget::Find(const Widget *widget)
+        void    Widget::Link(Widget* widget, Widget* previous)
         {
-            for (Widgets::iterator it = mChildren.begin(); it != mChildren.end(); ++it)
+            Widget* next = (previous) ? previous->mNextSibling : mFirstChild;
+            const Uint32 low = (previous) ? previous->mZKey : 0;
+            const Uint32 high = (next) ? next->mZKey : std::numeric_limits<Uint32>::max();
+
+            // The brothers are only renumbered when there is no key left between them
+            const bool renumber = (high - low < 2) || (!next && high - low <= _zKeyGap);
+
+            widget->mZKey = (next) ? low + (high - low) / 2 : low + _zKeyGap;
+
+            widget->mPrevSibling = previous;
+            widget->mNextSibling = next;
+
+            if (previous)
+                previous->mNextSibling = widget;
+            else
+                mFirstChild = widget;
+
+            if (next)
+                next->mPrevSibling = widget;
+            else
+                mLastChild = widget;
+
+            if (renumber)
             {
-                if (*it == widget)
-                    return (it);
+                Uint32 key = 0;
+
+                for (Widget* child = mFirstChild; child; child = child->mNextSibling)
+                    child->mZKey = (key += _zKeyGap);
             }
-            return (mChildren.end());
+
+            mChildrenChanged = true;
+            InvalidateMeasure();
+        }
+
+        void    Widget::Unlink(Widget* widget)
+        {
+            if (widget->mPrevSibling)
+                widget->mPrevSibling->mNextSibling = widget->mNextSibling;
+            else
+                mFirstChild = widget->mNextSibling;
+
+            if (widget->mNextSibling)
+                widget->mNextSibling->mPrevSibling = widget->mPrevSibling;
+            else
+                mLastChild = widget->mPrevSibling;
+
+            widget->mPrevSibling = widget->mNextSibling = 0;
+            mChildrenChanged = true;
+            InvalidateMeasure();
         }
 
         void    Widget::UpdatePosition()
         {
+            ProfileScope scope(Profiler::LAYOUT, this);
+
             if (!mParent || mAlign == Align::NONE)
               return;
 
@@ -336,39 +571,26 @@ namespace sf
             Move(mAlignOffset);
         }
 
+        bool    Widget::IsAbove(const Widget* brother) const
+        {
+            return (brother && mParent && brother->mParent == mParent && mZKey > brother->mZKey);
+        }
+
         Widget* Widget::GetBrotherAt(Widget::ZIndex op)
         {
             if (!mParent)
                 return 0;
 
-            Widgets& container = mParent->mChildren;
-            Widget* brother = 0;
-            size_t i = 0;
-
-            for (size_t size = container.size(); i < size; ++i)
-            {
-                if (container.at(i) == this)
-                    break;
-            }
-
             if (op == Widget::ALL_BELOW)
-            {
-                brother = container.front();
-            }
+                return mParent->mFirstChild;
             else if (op == Widget::ALL_ABOVE)
-            {
-                brother = container.back();
-            }
-            else if (op == Widget::UP && i < container.size() - 1)
-            {
-                brother = container.at(i + 1);
-            }
-            else if (op == Widget::DOWN && i > 0)
-            {
-                brother = container.at(i - 1);
-            }
+                return mParent->mLastChild;
+            else if (op == Widget::UP)
+                return mNextSibling;
+            else if (op == Widget::DOWN)
+                return mPrevSibling;
 
-            return brother;
+            return 0;
         }
 
         void    Widget::ChangeZIndex(Widget::ZIndex op)
@@ -376,42 +598,38 @@ namespace sf
             if (!mParent)
                 return;
 
-            Widgets& container = mParent->mChildren;
-            size_t i = 0;
-
-            for (size_t size = container.size(); i < size; ++i)
-            {
-                if (container.at(i) == this)
-                    break;
-            }
+            Widget* previous = mPrevSibling;
 
             if (op == ALL_ABOVE)
-            {
-                container.erase(container.begin() + i);
-                container.push_back(this);
-            }
+                previous = mParent->mLastChild;
             else if (op == ALL_BELOW)
-            {
-                container.erase(container.begin() + i);
-                container.insert(container.begin(), this);
-            }
-            else if (op == DOWN && i > 0)
-            {
-                std::swap(container[i], container[i - 1]);
-            }
-            else if (op == UP && i < container.size() - 1)
-            {
-                std::swap(container[i], container[i + 1]);
-            }
+                previous = 0;
+            else if (op == DOWN && mPrevSibling)
+                previous = mPrevSibling->mPrevSibling;
+            else if (op == UP && mNextSibling)
+                previous = mNextSibling;
+
+            if (previous == this || previous == mPrevSibling)
+                return;
 
+            Widget* parent = mParent;
+
+            parent->Unlink(this);
+            parent->Link(this, previous);
         }
 
         void    Widget::Add(Widget* widget)
         {
-            if (Find(widget) != mChildren.end())
+            if (widget->mParent == this)
                 return;
 
-            mChildren.push_back(widget);
+            if (widget->mParent)
+            {
+                widget->mParent->Unlink(widget);
+                widget->mParent->OnChildRemoved(widget);
+            }
+
+            Link(widget, mLastChild);
             widget->mParent = this;
             widget->UpdatePosition();
             widget->OnChange(Widget::PARENT);
@@ -419,12 +637,11 @@ namespace sf
 
         void    Widget::Remove(Widget* widget)
         {
-            Widgets::iterator   it = Find(widget);
-
-            if (it == mChildren.end())
+            if (widget->mParent != this)
                 return;
 
-            mChildren.erase(it);
+            Unlink(widget);
+            OnChildRemoved(widget);
             widget->mParent = 0;
             widget->OnChange(Widget::PARENT);
         }
@@ -479,29 +696,50 @@ namespace sf
             }
         }
 
-        void    Widget::RenderChildren(RenderTarget& target, RenderQueue& queue) const
+        void    Widget::OnChange(Widget::Property property)
         {
-            if (!mVisible)
-                return;
-
-            for (Widgets::const_iterator it = mChildren.begin(); it != mChildren.end(); ++it)
+            if (property == SIZE)
             {
-                Widget* widg = *it;
-
-                if (widg->IsVisible())
-                    target.Draw(*widg);
+                for (Widget* child = mFirstChild; child; child = child->mNextSibling)
+                {
+                    child->UpdatePosition();
+                }
             }
         }
 
-        void    Widget::OnChange(Widget::Property property)
+        void    Widget::OnChildRemoved(const Widget*)
         {
-            if (property == SIZE)
+
+        }
+
+        void    Widget::OnLayout()
+        {
+
+        }
+
+        Vector2f    Widget::OnMeasure() const
+        {
+            return mPreferredSize;
+        }
+
+        void    Widget::UpdateLayout()
+        {
+            if (mLayoutValid && mChildLayoutValid)
+                return;
+
+            // Parents are arranged before their children, which are measured once for both
+            if (!mLayoutValid)
             {
-                for (Widgets::iterator it = mChildren.begin(); it != mChildren.end(); ++it)
-                {
-                    (*it)->UpdatePosition();
-                }
+                OnLayout();
+
+                // A widget resized by its own OnLayout() is laid out already
+                mLayoutValid = true;
             }
+
+            mChildLayoutValid = true;
+
+            for (Widget* child = mFirstChild; child; child = child->mNextSibling)
+                child->UpdateLayout();
         }
 
         void    Widget::UseScissor(bool useScissor)
@@ -509,35 +747,73 @@ namespace sf
             mUseScissor = useScissor;
         }
 
-        void    Widget::OnPaint(RenderTarget& target, RenderQueue& queue) const
+        void*   Widget::operator new(std::size_t size)
         {
-            queue.SetColor(GetColor());
-            target.Draw(Shape::Rectangle(0, 0, mSize.x, mSize.y, GetColor(), 1.f, GetBorderColor()));
+            void* memory = WidgetPool::Allocate(size);
+
+            if (mInitialPending && !mInitialMemory)
+                mInitialMemory = memory;
+
+            return memory;
         }
 
-        void    Widget::Render(RenderTarget& target, RenderQueue& queue) const
+        void    Widget::operator delete(void* memory, std::size_t size)
+        {
+            WidgetPool::Release(memory, size);
+        }
+
+        void    Widget::OnPaint(Painter& painter) const
         {
-            OnPaint(target, queue);
+            const Color& color = GetColor();
+            const Color& borderColor = GetBorderColor();
 
-            if (mUseScissor)
-            {
-                Area& area = ResourceManager::Get()->WidgetArea;
-                area.PushArea(GetRect(true));
-                const FloatRect& top = area.GetTopArea();
+            // Transparent backgrounds and borders add no geometry
+            if (color.a == 0 && borderColor.a == 0)
+                return;
+
+            // The mesh vertices are only computed again when the size changes
+            mMesh.SetGeometry(mSize, (borderColor.a > 0) ? 1.f : 0.f);
+            mMesh.SetColors(color, borderColor);
+            painter.DrawMesh(mMesh);
+        }
+
+        void    Widget::Paint(Painter& painter) const
+        {
+            if (!mVisible || mOpacity <= 0.f)
+                return;
 
-                target.Flush();
+            const float parentOpacity = painter.GetOpacity();
 
-                RenderChildren(target, queue);
+            painter.Translate(GetPosition());
+            painter.SetOpacity(parentOpacity * mOpacity);
 
-                queue.SetScissor(true, Vector2f(top.Left, target.GetHeight() - top.Bottom), Vector2f(top.GetSize().x, top.GetSize().y));
-                target.Flush();
-                area.PopArea();
-            }
-            else
             {
-                queue.SetScissor(false);
-                RenderChildren(target, queue);
+                ProfileScope scope(Profiler::PAINT, this);
+                OnPaint(painter);
             }
+
+            if (mUseScissor)
+                painter.PushClip(FloatRect(0, 0, mSize.x, mSize.y));
+
+            for (Widget* child = mFirstChild; child; child = child->mNextSibling)
+                child->Paint(painter);
+
+            if (mUseScissor)
+                painter.PopClip();
+
+            painter.SetOpacity(parentOpacity);
+            painter.Translate(-GetPosition());
+        }
+
+        void    Widget::Render(RenderTarget& target, RenderQueue& queue) const
+        {
+            ProfileScope scope(Profiler::RENDER, this);
+
+            // The target is transformed for this widget : its whole tree is painted by one painter
+            SfmlPainter painter(target, queue, GetAbsolutePosition());
+
+            painter.Translate(-GetPosition());
+            Paint(painter);
         }
     }
 }
@@ -0,0 +1,217 @@
+/*
+    Copyright (c) 2009, Robin RUAUX
+    All rights reserved.
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+        * Redistributions of source code must retain the above copyright
+          notice, this list of conditions and the following disclaimer.
+        * Redistributions in binary form must reproduce the above copyright
+          notice, this list of conditions and the following disclaimer in the
+          documentation and/or other materials provided with the distribution.
+        * Neither the name of the University of California, Berkeley nor the
+          names of its contributors may be used to endorse or promote products
+          derived from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+    EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE REGENTS AND CONTRIBUTORS BE LIABLE FOR ANY
+    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <new>
+#include <vector>
+
+#include <SFUI/CheckBox.hpp>
+#include <SFUI/DockSpace.hpp>
+#include <SFUI/GridDecorator.hpp>
+#include <SFUI/Layout.hpp>
+#include <SFUI/ProfilerOverlay.hpp>
+#include <SFUI/RadioButton.hpp>
+#include <SFUI/Slider.hpp>
+#include <SFUI/TextButton.hpp>
+#include <SFUI/TextInput.hpp>
+#include <SFUI/WidgetPool.hpp>
+#include <SFUI/Window.hpp>
+
+namespace sf
+{
+    namespace ui
+    {
+        static const std::size_t    _Granularity = 16;
+
+        static const std::size_t    _MaxPooledSize = 4096;
+
+        static const std::size_t    _WidgetsPerBlock = 32;
+
+        /** Every widget shipped with the library is pooled : the build fails if one grows past the largest size class */
+        #define SFUI_CHECK_POOLED(Class) typedef char _Pooled##Class[sizeof(Class) <= _MaxPooledSize ? 1 : -1]
+
+        SFUI_CHECK_POOLED(CheckBox);
+        SFUI_CHECK_POOLED(DockSpace);
+        SFUI_CHECK_POOLED(Flex);
+        SFUI_CHECK_POOLED(Grid);
+        SFUI_CHECK_POOLED(GridDecorator);
+        SFUI_CHECK_POOLED(HBox);
+        SFUI_CHECK_POOLED(ProfilerOverlay);
+        SFUI_CHECK_POOLED(RadioButton);
+        SFUI_CHECK_POOLED(Slider);
+        SFUI_CHECK_POOLED(TextButton);
+        SFUI_CHECK_POOLED(TextInput);
+        SFUI_CHECK_POOLED(VBox);
+        SFUI_CHECK_POOLED(Window);
+
+        #undef SFUI_CHECK_POOLED
+
+        /** Free memory slot, stored in the slot itself */
+        struct _FreeSlot
+        {
+            _FreeSlot*  Next;
+        };
+
+        /** Size classes and their reserved blocks */
+        class _Pool
+        {
+            public :
+
+                _Pool()
+                    :   mAllocated(0),
+                        mReserved(0)
+                {
+                    for (std::size_t i = 0; i < _MaxPooledSize / _Granularity; ++i)
+                    {
+                        mFreeCounts[i] = 0;
+                        mFreeSlots[i] = 0;
+                    }
+                }
+
+                void*   Allocate(std::size_t index)
+                {
+                    if (!mFreeSlots[index])
+                        Reserve(index, _WidgetsPerBlock);
+
+                    _FreeSlot* slot = mFreeSlots[index];
+
+                    mFreeSlots[index] = slot->Next;
+                    --mFreeCounts[index];
+                    ++mAllocated;
+
+                    return slot;
+                }
+
+                void    Release(void* memory, std::size_t index)
+                {
+                    _FreeSlot* slot = static_cast<_FreeSlot*>(memory);
+
+                    slot->Next = mFreeSlots[index];
+                    mFreeSlots[index] = slot;
+                    ++mFreeCounts[index];
+                    --mAllocated;
+                }
+
+                std::size_t     GetFreeCount(std::size_t index) const
+                {
+                    return mFreeCounts[index];
+                }
+
+                void    Reserve(std::size_t index, std::size_t count)
+                {
+                    const std::size_t slotSize = (index + 1) * _Granularity;
+                    char* block = static_cast<char*>(::operator new(slotSize * count));
+
+                    mBlocks.push_back(block);
+                    mReserved += slotSize * count;
+                    mFreeCounts[index] += count;
+
+                    // The slots of the block are handed out in address order
+                    for (std::size_t i = count; i > 0; --i)
+                    {
+                        _FreeSlot* slot = reinterpret_cast<_FreeSlot*>(block + (i - 1) * slotSize);
+
+                        slot->Next = mFreeSlots[index];
+                        mFreeSlots[index] = slot;
+                    }
+                }
+
+                unsigned int    mAllocated;
+
+                std::size_t     mReserved;
+
+            private :
+
+                std::size_t         mFreeCounts[_MaxPooledSize / _Granularity];
+
+                _FreeSlot*          mFreeSlots[_MaxPooledSize / _Granularity];
+
+                std::vector<char*>  mBlocks;
+        };
+
+        /** The pool is never destroyed : static widgets may be deleted after a static pool would be.
+         * Its blocks are given back to the system at exit. Only the GUI thread may use it. */
+        static _Pool&   _GetPool()
+        {
+            static _Pool* pool = new _Pool();
+
+            return *pool;
+        }
+
+        void*   WidgetPool::Allocate(std::size_t size)
+        {
+            if (size == 0 || size > _MaxPooledSize)
+                return ::operator new(size);
+
+            return _GetPool().Allocate((size - 1) / _Granularity);
+        }
+
+        void    WidgetPool::Release(void* memory, std::size_t size)
+        {
+            if (!memory)
+                return;
+
+            if (size == 0 || size > _MaxPooledSize)
+                ::operator delete(memory);
+            else
+                _GetPool().Release(memory, (size - 1) / _Granularity);
+        }
+
+        std::size_t     WidgetPool::GetSlotSize(std::size_t size)
+        {
+            if (size == 0 || size > _MaxPooledSize)
+                return size;
+
+            return ((size - 1) / _Granularity + 1) * _Granularity;
+        }
+
+        void    WidgetPool::Reserve(std::size_t size, unsigned int count)
+        {
+            if (size == 0 || size > _MaxPooledSize || count == 0)
+                return;
+
+            const std::size_t index = (size - 1) / _Granularity;
+            _Pool& pool = _GetPool();
+
+            // Free slots of the size class are used first, only the missing ones are reserved
+            if (pool.GetFreeCount(index) < count)
+                pool.Reserve(index, count - pool.GetFreeCount(index));
+        }
+
+        unsigned int    WidgetPool::GetAllocatedCount()
+        {
+            return _GetPool().mAllocated;
+        }
+
+        std::size_t     WidgetPool::GetReservedSize()
+        {
+            return _GetPool().mReserved;
+        }
+
+    }
+
+}
@@ -41,7 +41,7 @@ namespace sf
                 mTitle(title)
         {
             SetDefaultStyle("BI_Window");
-            LoadStyle(GetDefaultStyle());
+            LoadStyle(GetInitialStyle());
 
             Add(&mDecorator);
             Add(&mTitle);
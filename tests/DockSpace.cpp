@@ -0,0 +1,70 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <SFUI.hpp>
+
+using namespace sf;
+
+namespace
+{
+    int     Fail(const std::string& message)
+    {
+        std::cerr << "DockSpace : " << message << std::endl;
+        return EXIT_FAILURE;
+    }
+}
+
+int     main()
+{
+    ui::DockSpace dockSpace;
+    dockSpace.SetSize(400.f, 300.f);
+
+    // Docked along a side of the empty space, the first window takes the whole space
+    ui::Window* first = new ui::Window(L"First");
+
+    if (!dockSpace.Dock(first, 0, ui::DockSpace::LEFT))
+        return Fail("could not dock the first window");
+
+    if (first->GetWidth() != dockSpace.GetWidth() || first->GetHeight() != dockSpace.GetHeight())
+        return Fail("the first window left an empty area beside it");
+
+    ui::Window* second = new ui::Window(L"Second");
+    ui::Window* third = new ui::Window(L"Third");
+
+    dockSpace.Dock(second, first, ui::DockSpace::RIGHT);
+    dockSpace.Dock(third, second, ui::DockSpace::TAB);
+
+    // A deleted tab is forgotten, the other tab of its area is shown
+    delete third;
+
+    if (dockSpace.GetActiveTab(second) != second || !second->IsVisible())
+        return Fail("the deleted tab is still the active tab");
+
+    // A deleted window is undocked, its area is merged with its neighbour
+    delete second;
+
+    if (first->GetWidth() != dockSpace.GetWidth())
+        return Fail("the area of the deleted window was not merged");
+
+    // A removed window is undocked, and can be docked again
+    dockSpace.Remove(first);
+
+    if (dockSpace.IsDocked(first))
+        return Fail("the removed window is still docked");
+
+    ui::Window* fourth = new ui::Window(L"Fourth");
+
+    if (!dockSpace.Dock(fourth) || !dockSpace.Dock(first, fourth, ui::DockSpace::BOTTOM))
+        return Fail("could not dock beside a window after a removal");
+
+    if (first->GetWidth() != dockSpace.GetWidth() || fourth->GetWidth() != dockSpace.GetWidth())
+        return Fail("the windows don't share the whole space");
+
+    delete first;
+    delete fourth;
+
+    ui::ResourceManager::Kill();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,68 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <SFML/System.hpp>
+#include <SFUI.hpp>
+
+using namespace sf;
+
+namespace
+{
+    const char* styleFile = "hotreload_test.xml";
+
+    bool    WriteStyle(const std::string& color)
+    {
+        std::ofstream file(styleFile);
+
+        file << "<style name=\"HotReloadTest\" color=\"" << color << "\" />" << std::endl;
+        return file.good();
+    }
+
+    int     Fail(const std::string& message)
+    {
+        std::cerr << "HotReload : " << message << std::endl;
+        return EXIT_FAILURE;
+    }
+}
+
+int     main()
+{
+    ui::ResourceManager* rm = ui::ResourceManager::Get();
+
+    if (!WriteStyle("#FF0000") || !rm->AddStylesFromFile(styleFile))
+        return Fail("could not load the style file");
+
+    ui::Widget* widget = new ui::Widget();
+    widget->LoadStyle("HotReloadTest");
+
+    if (widget->GetColor() != Color(255, 0, 0))
+        return Fail("the style was not applied");
+
+    // The file was loaded before hot reload is enabled : it must be watched anyway
+    rm->EnableHotReload(true);
+
+    // Modification times may only have a one second precision
+    Sleep(1.1f);
+
+    if (!WriteStyle("#00FF00"))
+        return Fail("could not write the style file");
+
+    for (unsigned int i = 0; i < 60 && widget->GetColor() != Color(0, 255, 0); ++i)
+    {
+        rm->ReloadChangedStyles();
+        Sleep(0.05f);
+    }
+
+    if (widget->GetColor() != Color(0, 255, 0))
+        return Fail("the changed style was not re-applied");
+
+    delete widget;
+    rm->EnableHotReload(false);
+    ui::ResourceManager::Kill();
+
+    std::remove(styleFile);
+    return EXIT_SUCCESS;
+}
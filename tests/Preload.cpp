@@ -0,0 +1,58 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <SFUI.hpp>
+
+using namespace sf;
+
+namespace
+{
+    int     Fail(const std::string& message)
+    {
+        std::cerr << "Preload : " << message << std::endl;
+        return EXIT_FAILURE;
+    }
+}
+
+int     main()
+{
+    ui::Profiler::Enable();
+
+    ui::PreloadStats stats;
+
+    if (!ui::ResourceManager::Get()->Preload("data/default_style.xml", &stats))
+        return Fail("could not preload the default styles");
+
+    ui::Profiler::EndFrame();
+
+    if (ui::Profiler::GetFrame().Counters[ui::Profiler::FONT_LOADS] == 0)
+        return Fail("no font was loaded by the preload");
+
+    // Widgets using the default styles must find their fonts in the cache
+    std::vector<ui::Widget*> widgets;
+
+    widgets.push_back(new ui::Label(L"Label"));
+    widgets.push_back(new ui::TextButton(L"Button"));
+    widgets.push_back(new ui::CheckBox(L"CheckBox"));
+    widgets.push_back(new ui::TextInput(L"Input"));
+    widgets.push_back(new ui::Window(L"Window"));
+
+    ui::Profiler::EndFrame();
+
+    const unsigned int loads = ui::Profiler::GetFrame().Counters[ui::Profiler::FONT_LOADS];
+
+    for (size_t i = 0; i < widgets.size(); ++i)
+        delete widgets[i];
+
+    ui::ResourceManager::Kill();
+
+    if (loads > 0)
+    {
+        std::cerr << "Preload : " << loads << " font(s) loaded after the preload" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
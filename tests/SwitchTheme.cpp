@@ -0,0 +1,80 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <SFUI.hpp>
+
+using namespace sf;
+
+namespace
+{
+    const char* firstTheme = "theme_first_test.xml";
+    const char* secondTheme = "theme_second_test.xml";
+
+    bool    WriteTheme(const char* filename, const std::string& fontSize, const std::string& image)
+    {
+        std::ofstream file(filename);
+
+        file << "<resources>" << std::endl;
+        file << "  <font name=\"ThemeFont\" src=\"data/dejavu.ttf\" size=\"" << fontSize << "\" />" << std::endl;
+        file << "  <image name=\"ThemeImage\" src=\"" << image << "\" />" << std::endl;
+        file << "</resources>" << std::endl;
+        file << "<style name=\"ThemeLabel\" font=\"ThemeFont\" />" << std::endl;
+        file << "<style name=\"ThemeIcon\" image=\"ThemeImage\" />" << std::endl;
+        return file.good();
+    }
+
+    int     Fail(const std::string& message)
+    {
+        std::cerr << "SwitchTheme : " << message << std::endl;
+        return EXIT_FAILURE;
+    }
+}
+
+int     main()
+{
+    ui::ResourceManager* rm = ui::ResourceManager::Get();
+
+    // Both themes define the same aliases, with another font size and image
+    if (!WriteTheme(firstTheme, "12", "data/checkbox.png") || !WriteTheme(secondTheme, "20", "data/btnNormal.png"))
+        return Fail("could not write the theme files");
+
+    if (!rm->SwitchTheme(firstTheme))
+        return Fail("could not load the first theme");
+
+    ui::Label* label = new ui::Label(L"Label");
+    ui::Icon* icon = new ui::Icon();
+
+    label->LoadStyle("ThemeLabel");
+    icon->LoadStyle("ThemeIcon");
+
+    if (icon->GetWidth() != 14.f)
+        return Fail("the first theme image was not applied");
+
+    if (!rm->SwitchTheme(secondTheme))
+        return Fail("could not load the second theme");
+
+    // The styles are the same, the widgets are restyled because their aliases changed
+    if (&label->GetFont() != rm->GetFont("ThemeFont") || rm->GetFont("ThemeFont") != rm->GetFont("data/dejavu.ttf", 20.f))
+        return Fail("the redefined font alias kept the font of the first theme");
+
+    if (icon->GetWidth() != 60.f || rm->GetImage("ThemeImage").GetImage()->GetWidth() != 60)
+        return Fail("the redefined image alias kept the image of the first theme");
+
+    // Switching back gives the first definitions again
+    if (!rm->SwitchTheme(firstTheme))
+        return Fail("could not switch back to the first theme");
+
+    if (&label->GetFont() != rm->GetFont("data/dejavu.ttf", 12.f) || icon->GetWidth() != 14.f)
+        return Fail("switching back didn't restore the first theme aliases");
+
+    delete label;
+    delete icon;
+    ui::ResourceManager::Kill();
+
+    std::remove(firstTheme);
+    std::remove(secondTheme);
+    return EXIT_SUCCESS;
+}
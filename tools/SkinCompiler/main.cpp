@@ -0,0 +1,20 @@
+
+#include <cstdlib>
+#include <iostream>
+
+#include <SFUI/SkinFile.hpp>
+
+int main(int ac, char **av)
+{
+    if (ac != 3)
+    {
+        std::cerr << "Usage : " << av[0] << " <style.xml> <output.skin>" << std::endl;
+        return (EXIT_FAILURE);
+    }
+
+    // Styles are compiled as they are, resources are only declared (nothing is loaded here)
+    if (!sf::ui::SkinFile::Compile(av[1], av[2]))
+        return (EXIT_FAILURE);
+
+    return (EXIT_SUCCESS);
+}